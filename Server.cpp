@@ -0,0 +1,175 @@
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "QueryProtocol.h"
+#include "WaveletMatrix.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Servidor de consultas residente: construye el arbol una sola vez y atiende
+// contains, countAll, findAll (paginado) y rangos del arreglo de sufijos por
+// un socket Unix con el protocolo de include/QueryProtocol.h. Un hilo por
+// conexion, a lo sumo kMaxConnections a la vez (las demas esperan en la cola
+// de listen); cada hilo lee de a bloques y contesta todos los pedidos
+// completos que llegaron antes de escribir, asi los pedidos encadenados
+// (pipelining) comparten las llamadas al sistema. findAll pagina con un
+// cursor de posicion sobre el arreglo de sufijos y su wavelet matrix: cada
+// pagina cuesta O(|P| log n + limite log n) sin importar cuantas ocurrencias
+// tenga el patron ni en que pagina se este.
+// Uso: ./server [socket] [archivo] [n]
+
+constexpr ptrdiff_t kMaxConnections = 64;
+constexpr size_t kFlushBytes = 1 << 20; // respuestas acumuladas antes de escribir
+
+long long now_ms() { return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+template <class Tree> struct Server {
+    const Tree &tree;
+    PositionRangeIndex<typename Tree::Pos> index; // toSuffixArray, calculado al cargar
+
+    // Responde un pedido agregando cabecera y posiciones a out.
+    void answer(const RequestHeader &h, string_view P, string &out) const {
+        const auto &SA = index.suffixArray();
+        ResponseHeader r;
+        r.id = h.id;
+        vector<uint64_t> positions;
+
+        switch (h.op) {
+        case OpContains:
+            r.value = tree.contains(P);
+            break;
+        case OpCountAll:
+            r.value = tree.countAll(P);
+            break;
+        case OpFindAll: {
+            uint64_t limit = min<uint64_t>(h.b, kMaxReplyPositions);
+            if (limit > 0)
+                index.report(tree.s, P, h.a, SA.size(), [&](auto pos) {
+                    positions.push_back(pos);
+                    return positions.size() < limit;
+                });
+            r.value = positions.size();
+            break;
+        }
+        case OpSuffixArray: {
+            if (h.a > SA.size()) {
+                r.status = StatusBadRequest;
+                break;
+            }
+            uint64_t cnt = min<uint64_t>({h.b, SA.size() - h.a, kMaxReplyPositions});
+            positions.assign(SA.begin() + h.a, SA.begin() + h.a + cnt);
+            r.value = cnt;
+            break;
+        }
+        case OpInfo:
+            r.value = SA.size();
+            break;
+        default:
+            r.status = StatusBadRequest;
+        }
+
+        r.count = positions.size();
+        out.append((const char *)&r, sizeof r);
+        out.append((const char *)positions.data(), positions.size() * sizeof(uint64_t));
+    }
+
+    void serve(int fd) const {
+        string in, out;
+        char chunk[1 << 16];
+        size_t used = 0; // bytes de in ya respondidos
+
+        while (true) {
+            ssize_t r = read(fd, chunk, sizeof chunk);
+            if (r <= 0)
+                break;
+            in.append(chunk, r);
+
+            bool bad = false;
+            while (in.size() - used >= sizeof(RequestHeader)) {
+                RequestHeader h;
+                memcpy(&h, in.data() + used, sizeof h);
+                if (h.len > kMaxPatternBytes) {
+                    bad = true;
+                    break;
+                }
+                if (in.size() - used < sizeof h + h.len)
+                    break;
+                answer(h, string_view(in).substr(used + sizeof h, h.len), out);
+                used += sizeof h + h.len;
+                if (out.size() >= kFlushBytes) {
+                    if (!sendAll(fd, out.data(), out.size())) {
+                        bad = true;
+                        break;
+                    }
+                    out.clear();
+                }
+            }
+
+            if (!out.empty() && !sendAll(fd, out.data(), out.size()))
+                break;
+            out.clear();
+            in.erase(0, used);
+            used = 0;
+            if (bad)
+                break;
+        }
+        close(fd);
+    }
+};
+
+int main(int argc, char **argv) {
+    string path = argc > 1 ? argv[1] : "/tmp/suffixtree.sock";
+    string file = argc > 2 ? argv[2] : "Bible.txt";
+    long long n = argc > 3 ? atoll(argv[3]) : (1LL << 62);
+
+    signal(SIGPIPE, SIG_IGN);
+
+    long long t0 = now_ms();
+    string text = loadText(file, n);
+    size_t chars = text.size();
+
+    return withLcpSuffixTree(move(text), [&](const auto &tree) {
+        using Tree = decay_t<decltype(tree)>;
+        Server<Tree> server{tree, {}};
+        server.index.build(tree.toSuffixArray());
+        cout << "Indice de " << chars << " caracteres listo en " << now_ms() - t0 << " ms\n";
+
+        int lfd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof addr.sun_path - 1);
+        unlink(path.c_str());
+        if (lfd < 0 || bind(lfd, (sockaddr *)&addr, sizeof addr) != 0 || listen(lfd, 128) != 0) {
+            perror("socket");
+            return 1;
+        }
+        cout << "Escuchando en " << path << "\n";
+
+        counting_semaphore<kMaxConnections> slots(kMaxConnections);
+        while (true) {
+            slots.acquire();
+            int fd = accept(lfd, nullptr, nullptr);
+            if (fd < 0) {
+                slots.release();
+                continue;
+            }
+            thread([&server, &slots, fd] {
+                server.serve(fd);
+                slots.release();
+            }).detach();
+        }
+        return 0;
+    });
+}
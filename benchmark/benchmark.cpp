@@ -1,270 +1,33 @@
 #include <chrono>
 #include <fstream>
 #include <iostream>
-#include <map>
-#include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
-using namespace std;
-
-// NAIVE
-
-class NaiveSuffixTree {
-    struct Node {
-        map<char, Node *> next;
-        int l, r;
-        int suf;
-        Node(int L, int R, int S = -1) : l(L), r(R), suf(S) {}
-    };
-
-    string s;
-    vector<unique_ptr<Node>> pool;
-    Node *root;
-
-    Node *newNode(int l, int r, int suf = -1) {
-        pool.push_back(make_unique<Node>(l, r, suf));
-        return pool.back().get();
-    }
-
-    void insertSuffix(int pos) {
-        Node *cur = root;
-        int i = pos, n = s.size();
-        while (i < n) {
-            char c = s[i];
-            if (!cur->next.count(c)) {
-                cur->next[c] = newNode(i, n - 1, pos);
-                return;
-            }
-            Node *e = cur->next[c];
-            int k = e->l;
-            while (k <= e->r && i < n && s[k] == s[i])
-                k++, i++;
-            if (k > e->r) {
-                cur = e;
-                continue;
-            }
-            Node *mid = newNode(e->l, k - 1);
-            cur->next[c] = mid;
-            e->l = k;
-            mid->next[s[k]] = e;
-            mid->next[s[i]] = newNode(i, n - 1, pos);
-            return;
-        }
-    }
-
-  public:
-    NaiveSuffixTree(const string &txt) {
-        s = txt;
-        root = newNode(-1, -1);
-        for (int i = 0; i < (int)s.size(); i++)
-            insertSuffix(i);
-    }
-};
-
-// MCCREIGHT
-
-class McCreightSuffixTree {
-    struct Node {
-        unordered_map<unsigned char, Node *> next;
-        Node *link = nullptr;
-        Node *parent = nullptr;
-        int l, r;
-        Node(int L = -1, int R = -1) : l(L), r(R) {}
-        int len() const { return r - l + 1; }
-    };
-
-    string s;
-    vector<unique_ptr<Node>> pool;
-    Node *root;
-
-    Node *newNode(int l, int r, Node *p = nullptr) {
-        pool.push_back(make_unique<Node>(l, r));
-        pool.back()->parent = p;
-        return pool.back().get();
-    }
-
-    pair<Node *, Node *> insertSuffix(int i, Node *head, Node *prev) {
-        Node *v = head;
-        if (v != root)
-            v = v->link ? v->link : root;
-
-        int j = i;
-        while (true) {
-            unsigned char c = s[j];
-            if (!v->next.count(c)) {
-                v->next[c] = newNode(j, s.size() - 1, v);
-                if (prev)
-                    prev->link = v;
-                return {v, nullptr};
-            }
-
-            Node *w = v->next[c];
-            int k = w->l;
-            while (k <= w->r && j < (int)s.size() && s[k] == s[j])
-                k++, j++;
-
-            if (k > w->r) {
-                v = w;
-                continue;
-            }
-
-            Node *mid = newNode(w->l, k - 1, v);
-            v->next[c] = mid;
-
-            w->l = k;
-            w->parent = mid;
-            mid->next[s[k]] = w;
-            mid->next[s[j]] = newNode(j, s.size() - 1, mid);
-
-            if (prev)
-                prev->link = mid;
-            return {mid, mid};
-        }
-    }
-
-  public:
-    McCreightSuffixTree(string txt) {
-        if (txt.empty() || txt.back() != '$')
-            txt.push_back('$');
-        s = txt;
-        root = newNode(-1, -1);
-        Node *cur = root;
-        Node *prev = nullptr;
-        for (int i = 0; i < (int)s.size(); i++)
-            tie(cur, prev) = insertSuffix(i, cur, prev);
-    }
-};
-
-// UKKONEN
-
-class UkkonenSuffixTree {
-    struct Node {
-        unordered_map<unsigned char, Node *> next;
-        Node *link = nullptr;
-        int start;
-        int *end;
-        Node(int s, int *e) : start(s), end(e) {}
-        int len() const { return *end - start + 1; }
-    };
-
-    string s;
-    vector<unique_ptr<Node>> pool;
-    vector<unique_ptr<int>> ends;
-    Node *root, *active;
-    int activeEdge = -1, activeLen = 0, rem = 0;
-    Node *last = nullptr;
-    int leafEnd = -1, rootEnd = -1;
-
-    Node *newNode(int s, int *e) {
-        pool.push_back(make_unique<Node>(s, e));
-        return pool.back().get();
-    }
-
-    int *newEnd(int v) {
-        ends.push_back(make_unique<int>(v));
-        return ends.back().get();
-    }
 
-    bool walk(Node *v) {
-        int L = v->len();
-        if (activeLen >= L) {
-            activeEdge += L;
-            activeLen -= L;
-            active = v;
-            return true;
-        }
-        return false;
-    }
-
-    void extend(int pos) {
-        leafEnd = pos;
-        rem++;
-        last = nullptr;
-
-        while (rem > 0) {
-            if (activeLen == 0)
-                activeEdge = pos;
-            unsigned char c = s[activeEdge];
-
-            if (!active->next.count(c)) {
-                active->next[c] = newNode(pos, &leafEnd);
-                if (last)
-                    last->link = active, last = nullptr;
-            } else {
-                Node *nxt = active->next[c];
-                if (walk(nxt))
-                    continue;
-
-                if (s[nxt->start + activeLen] == s[pos]) {
-                    if (last && active != root)
-                        last->link = active;
-                    activeLen++;
-                    break;
-                }
-
-                int *splitEnd = newEnd(nxt->start + activeLen - 1);
-                Node *split = newNode(nxt->start, splitEnd);
-                active->next[c] = split;
-
-                nxt->start += activeLen;
-                split->next[s[nxt->start]] = nxt;
-
-                split->next[s[pos]] = newNode(pos, &leafEnd);
-                if (last)
-                    last->link = split;
-                last = split;
-            }
+#include "McCreightSuffixTree.h"
+#include "NaiveSuffixTree.h"
+#include "UkkonenSuffixTree.h"
 
-            rem--;
-
-            if (active == root && activeLen > 0) {
-                activeLen--;
-                activeEdge = pos - rem + 1;
-            } else if (active != root) {
-                active = active->link ? active->link : root;
-            }
-        }
-    }
-
-  public:
-    UkkonenSuffixTree(string txt) {
-        if (txt.empty() || txt.back() != '$')
-            txt.push_back('$');
-        s = txt;
-        root = newNode(-1, &rootEnd);
-        root->link = root;
-        active = root;
-        for (int i = 0; i < (int)s.size(); i++)
-            extend(i);
-    }
-};
-
-string load_prefix(const string &fname, int limit) {
-    ifstream in(fname);
-    if (!in.is_open()) {
-        cerr << "Error archivo\n";
-        exit(1);
-    }
-    string text((istreambuf_iterator<char>(in)), {});
-    if ((int)text.size() > limit)
-        text.resize(limit);
-    if (text.empty() || text.back() != '$')
-        text.push_back('$');
-    return text;
-}
+using namespace std;
+using namespace suffixtree;
 
 long long now_ms() { return chrono::duration_cast<chrono::milliseconds>(chrono::high_resolution_clock::now().time_since_epoch()).count(); }
 
 // BENCHMARK
 
+// Compilar con -DSUFFIX_TREE_STATS para que los contadores no queden en cero.
+void dump_stats(ostream &out, int n, const string &name, const BuildStats &st) {
+    out << n << "," << name << "," << st.splits << "," << st.leaves << "," << st.linkHops << "," << st.walkDownSkips << ","
+        << st.charsCompared << "," << st.mapProbes << "\n";
+}
+
 struct Result {
     int n;
     long long t1, t2, t3;
 };
 
-Result bench(int n) {
-    string txt = load_prefix("Bible.txt", n);
+Result bench(int n, ostream &statsOut) {
+    string txt = loadText("Bible.txt", n);
     Result R;
     R.n = n;
 
@@ -278,17 +41,76 @@ Result bench(int n) {
     UkkonenSuffixTree c(txt);
     R.t3 = now_ms() - t0;
 
+    dump_stats(statsOut, n, "mccreight", b.buildStats());
+    dump_stats(statsOut, n, "ukkonen", c.buildStats());
+
     return R;
 }
 
+// Textos repetitivos: el peor caso para un McCreight sin rescan.
+string repetitive_text(const string &kind, int n) {
+    string t;
+    if (kind == "a") {
+        t.assign(n, 'a');
+    } else if (kind == "ab") {
+        for (int i = 0; i < n; i++)
+            t.push_back(i % 2 ? 'b' : 'a');
+    } else {
+        string prev = "b";
+        t.assign(1, 'a');
+        while ((int)t.size() < n) {
+            string nxt = t + prev;
+            prev = t;
+            t = nxt;
+        }
+        t.resize(n);
+    }
+    t.push_back('$');
+    return t;
+}
+
+// Duplicando n el tiempo (y los caracteres comparados) deben duplicarse.
+void bench_repetitive() {
+    vector<int> T = {100000, 200000, 400000, 800000, 1600000};
+    vector<string> kinds = {"a", "ab", "fibonacci"};
+
+    ofstream out("benchmark_repetitive.txt");
+    out << "kind,n,mccreight,ukkonen,mccreight_chars,ukkonen_chars\n";
+
+    for (const string &kind : kinds) {
+        for (int n : T) {
+            string txt = repetitive_text(kind, n);
+
+            auto t0 = now_ms();
+            McCreightSuffixTree b(txt);
+            long long tb = now_ms() - t0;
+            t0 = now_ms();
+            UkkonenSuffixTree c(txt);
+            long long tc = now_ms() - t0;
+
+            out << kind << "," << n << "," << tb << "," << tc << "," << b.buildStats().charsCompared << ","
+                << c.buildStats().charsCompared << "\n";
+        }
+    }
+}
+
 int main() {
     vector<int> T = {100, 2500, 5000, 7500, 10000, 15000, 20000, 25000, 30000, 35000, 40000, 45000, 50000};
 
     vector<Result> R;
     cout << "Ejecutando benchmark...\n";
 
+    // Sin SUFFIX_TREE_STATS los contadores quedan en cero: no se escribe el
+    // archivo y dump_stats escribe en un ostream sin buffer (se descarta).
+#ifdef SUFFIX_TREE_STATS
+    ofstream statsOut("benchmark_stats.txt");
+    statsOut << "n,engine,splits,leaves,linkHops,walkDownSkips,charsCompared,mapProbes\n";
+#else
+    ostream statsOut(nullptr);
+#endif
+
     for (int n : T)
-        R.push_back(bench(n));
+        R.push_back(bench(n, statsOut));
 
     ofstream out("benchmark_results.txt");
     out << "n,naive,mccreight,ukkonen\n";
@@ -296,5 +118,11 @@ int main() {
         out << x.n << "," << x.t1 << "," << x.t2 << "," << x.t3 << "\n";
 
     cout << "Listo. Guardado en benchmark_results.txt\n";
+
+    bench_repetitive();
+    cout << "Textos repetitivos guardados en benchmark_repetitive.txt\n";
+#ifdef SUFFIX_TREE_STATS
+    cout << "Contadores guardados en benchmark_stats.txt\n";
+#endif
     return 0;
 }
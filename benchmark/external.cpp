@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ExternalSuffixArray.h"
+#include "SuffixArray.h"
+#include "SuffixIndex.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Construccion en memoria externa con un presupuesto artificialmente chico.
+// Copia los primeros n caracteres de Bible.txt a external_text.txt, arma
+// external_text.sa.<i> con ExternalSuffixArray::build para cada presupuesto y
+// compara el arreglo y un lote de consultas contra buildSuffixArray en
+// memoria. Escribe benchmark_external.txt:
+//   chars,budget_bytes,rounds,runs,build_ms,peak_rss_kb,query_us,ok
+// Uso: ./external [n] [presupuesto_bytes]
+
+long long now_us() { return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+// pico de memoria residente del proceso (incluye las paginas mapeadas)
+long long peak_rss_kb() {
+    ifstream f("/proc/self/status");
+    string line;
+    while (getline(f, line))
+        if (line.rfind("VmHWM:", 0) == 0)
+            return atoll(line.c_str() + 6);
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    vector<size_t> budgets = {(size_t)1 << 16, (size_t)1 << 20, (size_t)16 << 20};
+    if (argc > 2)
+        budgets = {(size_t)atoll(argv[2])};
+
+    string text = loadText("Bible.txt", n);
+    text.pop_back(); // el fin del texto hace de terminador
+    const string textPath = "external_text.txt", saPath = "external_text.sa.";
+    ofstream(textPath, ios::binary) << text;
+
+    // primero todas las construcciones, para que el pico de memoria no
+    // incluya la referencia en memoria
+    vector<ExternalSuffixArray::BuildInfo> infos;
+    vector<long long> buildMs, rss;
+    for (size_t b = 0; b < budgets.size(); b++) {
+        long long t0 = now_us();
+        infos.push_back(ExternalSuffixArray::build(textPath, saPath + to_string(b), budgets[b]));
+        buildMs.push_back((now_us() - t0) / 1000);
+        rss.push_back(peak_rss_kb());
+    }
+
+    // referencia: con '\0' al final el fin del texto queda primero
+    vector<uint64_t> ref = buildSuffixArray<uint64_t>(text + '\0');
+    ref.erase(ref.begin());
+
+    mt19937 rng(7);
+    vector<string> P;
+    for (int q = 0; q < 2000; q++) {
+        int len = 1 + rng() % 12;
+        string p = text.substr(rng() % (text.size() - len), len);
+        if (q % 2)
+            p.back() ^= 1; // mitad con probable fallo
+        P.push_back(p);
+    }
+
+    // countAll esperado: el rango de cada patron en la referencia
+    size_t expected = 0;
+    for (const string &p : P) {
+        auto lo = lower_bound(ref.begin(), ref.end(), p,
+                              [&](uint64_t s, const string &x) { return text.compare(s, x.size(), x) < 0; });
+        auto hi = upper_bound(ref.begin(), ref.end(), p,
+                              [&](const string &x, uint64_t s) { return text.compare(s, x.size(), x) > 0; });
+        expected += hi - lo;
+    }
+
+    ofstream out("benchmark_external.txt");
+    out << "chars,budget_bytes,rounds,runs,build_ms,peak_rss_kb,query_us,ok\n";
+
+    for (size_t b = 0; b < budgets.size(); b++) {
+        ExternalSuffixArray sa(textPath, saPath + to_string(b));
+        bool ok = sa.size() == ref.size();
+        for (size_t i = 0; ok && i < ref.size(); i++)
+            ok = sa.at(i) == ref[i];
+
+        long long t0 = now_us();
+        size_t total = 0;
+        for (const string &p : P)
+            total += sa.countAll(p);
+        double queryUs = (double)(now_us() - t0) / P.size();
+        ok = ok && total == expected;
+
+        out << text.size() << "," << budgets[b] << "," << infos[b].rounds << "," << infos[b].runs << "," << buildMs[b]
+            << "," << rss[b] << "," << queryUs << "," << ok << "\n";
+        cout << "presupuesto " << budgets[b] << " B: " << infos[b].rounds << " rondas, " << infos[b].runs
+             << " corridas, " << buildMs[b] << " ms" << (ok ? "" : "  ERROR: no coincide con el arreglo en memoria")
+             << "\n";
+        remove((saPath + to_string(b)).c_str());
+    }
+
+    remove(textPath.c_str());
+    cout << "Listo. Guardado en benchmark_external.txt\n";
+    return 0;
+}
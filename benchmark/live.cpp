@@ -0,0 +1,118 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LiveSuffixIndex.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Ingesta en linea con lectores concurrentes. Un hilo agrega la Biblia en
+// bloques al LiveSuffixIndex mientras R lectores consultan contains sin parar.
+// Mide el rendimiento de la ingesta con y sin lectores y el de las consultas
+// con y sin ingesta. Escribe benchmark_live.txt:
+//   scenario,readers,publish_every,chars,ms,ingest_chars_per_s,queries,qps,snapshots
+// Uso: ./live [n] [publish_every]
+
+long long now_ms() { return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+const int kChunk = 4096;
+
+atomic<long long> sink{0}; // evita que se eliminen las consultas
+
+vector<string> make_patterns(const string &text, int count) {
+    mt19937 rng(7);
+    vector<string> P;
+    for (int q = 0; q < count; q++) {
+        int len = 3 + rng() % 10;
+        P.push_back(text.substr(rng() % (text.size() - len), len));
+    }
+    return P;
+}
+
+struct Result {
+    long long ms = 0, queries = 0;
+    size_t snapshots = 0;
+};
+
+// readers lectores consultan mientras (si ingest) se agrega text en bloques;
+// sin ingesta los lectores corren durante idleMs sobre un indice ya lleno.
+Result run(const string &text, const vector<string> &P, int readers, size_t every, bool ingest, long long idleMs) {
+    LiveSuffixIndex idx(every);
+    if (!ingest) {
+        idx.append(text);
+        idx.publish();
+    }
+
+    atomic<bool> done{false};
+    atomic<long long> queries{0};
+    vector<thread> th;
+    for (int r = 0; r < readers; r++) {
+        th.emplace_back([&, r] {
+            auto rd = idx.reader();
+            long long cnt = 0, hits = 0;
+            size_t i = r;
+            while (!done.load(memory_order_relaxed)) {
+                hits += rd.read([&](const LiveSuffixIndex::Tree &t) { return t.contains(P[i % P.size()]); });
+                i++;
+                cnt++;
+            }
+            queries += cnt;
+            sink += hits;
+        });
+    }
+
+    Result R;
+    long long t0 = now_ms();
+    if (ingest) {
+        for (size_t i = 0; i < text.size(); i += kChunk)
+            idx.append(string_view(text).substr(i, kChunk));
+        idx.publish();
+    } else {
+        this_thread::sleep_for(chrono::milliseconds(idleMs));
+    }
+    R.ms = max(1LL, now_ms() - t0);
+    done = true;
+    for (auto &t : th)
+        t.join();
+
+    R.queries = queries;
+    R.snapshots = idx.version();
+    return R;
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    size_t every = argc > 2 ? atoi(argv[2]) : 1 << 18;
+
+    string text = loadText("Bible.txt", n);
+    text.pop_back(); // el '$' lo pone cada instantanea
+    vector<string> P = make_patterns(text, 10000);
+
+    ofstream out("benchmark_live.txt");
+    out << "scenario,readers,publish_every,chars,ms,ingest_chars_per_s,queries,qps,snapshots\n";
+
+    auto row = [&](const string &scenario, int readers, const Result &R) {
+        double ingest = scenario == "query_only" ? 0 : text.size() * 1000.0 / R.ms;
+        double qps = R.queries * 1000.0 / R.ms;
+        out << scenario << "," << readers << "," << every << "," << text.size() << "," << R.ms << "," << (long long)ingest
+            << "," << R.queries << "," << (long long)qps << "," << R.snapshots << "\n";
+        cout << scenario << " lectores=" << readers << ": ingesta " << (long long)ingest << " car/s, " << (long long)qps
+             << " consultas/s\n";
+    };
+
+    Result alone = run(text, P, 0, every, true, 0);
+    row("ingest_only", 0, alone);
+    for (int readers : {1, 2, 4}) {
+        row("ingest_with_readers", readers, run(text, P, readers, every, true, 0));
+        row("query_only", readers, run(text, P, readers, every, false, alone.ms));
+    }
+
+    cout << "Listo. Guardado en benchmark_live.txt\n";
+    return 0;
+}
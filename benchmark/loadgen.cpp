@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "QueryProtocol.h"
+#include "SuffixIndex.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Generador de carga para el servidor de consultas (Server.cpp). Abre C
+// conexiones y en cada una mantiene D pedidos en vuelo (pipelining) durante
+// S segundos: 50% contains, 30% countAll, 15% findAll (10 posiciones) y 5%
+// rangos de 100 entradas del arreglo de sufijos. Mide la latencia de cada
+// pedido desde que se escribe hasta que llega su respuesta. Escribe
+// benchmark_server.txt:
+//   connections,depth,seconds,requests,qps,p50_us,p90_us,p99_us,p999_us,max_us,errors
+// Uso: ./loadgen [socket] [conexiones] [profundidad] [segundos]
+
+long long now_ns() { return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+int main(int argc, char **argv) {
+    string path = argc > 1 ? argv[1] : "/tmp/suffixtree.sock";
+    int conns = argc > 2 ? atoi(argv[2]) : 4;
+    int depth = argc > 3 ? atoi(argv[3]) : 16;
+    double seconds = argc > 4 ? atof(argv[4]) : 5;
+
+    string text = loadText("Bible.txt", 1LL << 62);
+    mt19937 rng(7);
+    vector<string> P;
+    for (int q = 0; q < 10000; q++) {
+        int len = 3 + rng() % 10;
+        P.push_back(text.substr(rng() % (text.size() - len), len));
+    }
+
+    int probe = connectUnix(path);
+    if (probe < 0) {
+        cerr << "Error: no se pudo conectar a " << path << "\n";
+        return 1;
+    }
+    string req;
+    appendRequest(req, 0, OpInfo, "");
+    ResponseHeader info;
+    vector<uint64_t> tmp;
+    if (!sendAll(probe, req.data(), req.size()) || !readResponse(probe, info, tmp)) {
+        cerr << "Error: el servidor no respondio\n";
+        return 1;
+    }
+    close(probe);
+    uint64_t saSize = info.value;
+
+    atomic<bool> stop{false};
+    atomic<long long> errors{0};
+    vector<vector<long long>> lat(conns);
+    vector<thread> th;
+    for (int c = 0; c < conns; c++) {
+        th.emplace_back([&, c] {
+            int fd = connectUnix(path);
+            if (fd < 0) {
+                errors++;
+                return;
+            }
+            mt19937 r(c + 1);
+            deque<long long> sent; // hora de envio de los pedidos en vuelo
+            uint32_t id = 0;
+
+            auto next = [&](string &out) {
+                const string &p = P[r() % P.size()];
+                int kind = r() % 100;
+                if (kind < 50)
+                    appendRequest(out, id++, OpContains, p);
+                else if (kind < 80)
+                    appendRequest(out, id++, OpCountAll, p);
+                else if (kind < 95)
+                    appendRequest(out, id++, OpFindAll, p, 0, 10);
+                else
+                    appendRequest(out, id++, OpSuffixArray, "", r() % saSize, 100);
+            };
+
+            string out;
+            for (int d = 0; d < depth; d++)
+                next(out);
+            long long t = now_ns();
+            for (int d = 0; d < depth; d++)
+                sent.push_back(t);
+            sendAll(fd, out.data(), out.size());
+
+            ResponseHeader h;
+            vector<uint64_t> pos;
+            while (!sent.empty()) {
+                if (!readResponse(fd, h, pos)) {
+                    errors++;
+                    break;
+                }
+                long long done = now_ns();
+                lat[c].push_back(done - sent.front());
+                sent.pop_front();
+                if (h.status != StatusOk)
+                    errors++;
+                if (!stop.load(memory_order_relaxed)) {
+                    out.clear();
+                    next(out);
+                    sent.push_back(now_ns());
+                    if (!sendAll(fd, out.data(), out.size())) {
+                        errors++;
+                        break;
+                    }
+                }
+            }
+            close(fd);
+        });
+    }
+
+    long long t0 = now_ns();
+    this_thread::sleep_for(chrono::duration<double>(seconds));
+    stop = true;
+    for (auto &t : th)
+        t.join();
+    double elapsed = (now_ns() - t0) / 1e9;
+
+    vector<long long> all;
+    for (auto &v : lat)
+        all.insert(all.end(), v.begin(), v.end());
+    sort(all.begin(), all.end());
+    auto pct = [&](double q) { return all.empty() ? 0 : all[min(all.size() - 1, (size_t)(q * all.size()))] / 1000; };
+
+    ofstream outFile("benchmark_server.txt", ios::app);
+    outFile.seekp(0, ios::end);
+    if (outFile.tellp() == 0)
+        outFile << "connections,depth,seconds,requests,qps,p50_us,p90_us,p99_us,p999_us,max_us,errors\n";
+    long long qps = (long long)(all.size() / elapsed);
+    outFile << conns << "," << depth << "," << elapsed << "," << all.size() << "," << qps << "," << pct(0.5) << ","
+            << pct(0.9) << "," << pct(0.99) << "," << pct(0.999) << "," << (all.empty() ? 0 : all.back() / 1000) << ","
+            << errors << "\n";
+    cout << conns << " conexiones x " << depth << " en vuelo: " << qps << " consultas/s, p50 " << pct(0.5)
+         << " us, p99 " << pct(0.99) << " us, p99.9 " << pct(0.999) << " us, errores " << errors << "\n";
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "Lz77.h"
+#include "SuffixArray.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Factorizacion LZ77 con el arreglo de sufijos (lz77Factorize, O(n)) contra
+// la busqueda ingenua del factor previo mas largo (O(n^2), solo hasta
+// naiveMax caracteres). Para cada tamano verifica que los largos de los
+// factores coincidan y que el flujo de Lz77Writer se decodifique al texto.
+// Escribe benchmark_lz77.txt:
+//   chars,method,ms,factors,literals,longest,est_bits_per_char,stream_bytes,ok
+// Uso: ./lz77 [n] [naive_max]
+
+long long now_ms() { return chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+// para cada posicion, la ocurrencia previa que mas se extiende (la primera)
+vector<Lz77Factor> naive_lz77(const string &t) {
+    vector<Lz77Factor> res;
+    size_t n = t.size();
+    for (size_t i = 0; i < n;) {
+        Lz77Factor f;
+        f.pos = i;
+        for (size_t j = 0; j < i; j++) {
+            size_t l = 0;
+            while (i + l < n && t[j + l] == t[i + l])
+                l++;
+            if (l > f.len) {
+                f.len = l;
+                f.src = j;
+            }
+        }
+        if (f.len == 0)
+            f.src = (unsigned char)t[i];
+        i += max<uint64_t>(1, f.len);
+        res.push_back(f);
+    }
+    return res;
+}
+
+int main(int argc, char **argv) {
+    long long full = argc > 1 ? atoll(argv[1]) : 1LL << 62;
+    size_t naiveMax = argc > 2 ? atoll(argv[2]) : 100000;
+
+    string bible = loadText("Bible.txt", full);
+    vector<size_t> sizes;
+    for (size_t n : {10000, 30000, 100000, 1000000})
+        if (n < bible.size())
+            sizes.push_back(n);
+    sizes.push_back(bible.size());
+
+    ofstream out("benchmark_lz77.txt");
+    out << "chars,method,ms,factors,literals,longest,est_bits_per_char,stream_bytes,ok\n";
+
+    for (size_t n : sizes) {
+        string text = bible.substr(0, n);
+        if (text.back() != '$')
+            text.push_back('$');
+
+        long long t0 = now_ms();
+        vector<uint32_t> SA = buildSuffixArray<uint32_t>(text);
+        ostringstream stream;
+        Lz77Writer writer(stream);
+        vector<uint64_t> lens;
+        Lz77Stats st = lz77Factorize(text, SA, [&](const Lz77Factor &f) {
+            writer(f);
+            lens.push_back(f.len);
+        });
+        long long ms = now_ms() - t0;
+
+        istringstream in(stream.str());
+        bool ok = lz77Decode(in) == text;
+
+        auto row = [&](const char *method, long long ms, const Lz77Stats &s, uint64_t bytes, bool ok) {
+            out << text.size() << "," << method << "," << ms << "," << s.factors << "," << s.literals << ","
+                << s.longest << "," << s.bitsPerChar() << "," << bytes << "," << ok << "\n";
+            cout << method << " n=" << text.size() << ": " << ms << " ms, " << s.factors << " factores, "
+                 << s.bitsPerChar() << " bits/car" << (ok ? "" : "  ERROR") << "\n";
+        };
+
+        if (n <= naiveMax) {
+            long long t1 = now_ms();
+            vector<Lz77Factor> naive = naive_lz77(text);
+            long long naiveMs = now_ms() - t1;
+            Lz77Stats ns;
+            bool same = naive.size() == lens.size();
+            for (size_t i = 0; i < naive.size(); i++) {
+                ns.add(naive[i]);
+                same = same && naive[i].len == lens[i];
+            }
+            ok = ok && same;
+            row("naive", naiveMs, ns, 0, same);
+        }
+        row("suffix_array", ms, st, writer.bytes(), ok);
+    }
+
+    // desde un arbol ya construido (sin contar su construccion)
+    LcpSuffixTree tree(bible);
+    long long t0 = now_ms();
+    Lz77Stats st = lz77Factorize(tree, [](const Lz77Factor &) {});
+    long long ms = now_ms() - t0;
+    out << tree.s.size() << ",lcp_tree," << ms << "," << st.factors << "," << st.literals << "," << st.longest << ","
+        << st.bitsPerChar() << ",0,1\n";
+    cout << "lcp_tree n=" << tree.s.size() << ": " << ms << " ms\n";
+
+    cout << "Listo. Guardado en benchmark_lz77.txt\n";
+    return 0;
+}
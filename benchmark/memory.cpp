@@ -0,0 +1,184 @@
+#include <malloc.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "McCreightSuffixTree.h"
+#include "NormalizedSuffixTree.h"
+#include "NaiveSuffixTree.h"
+#include "SparseSuffixTree.h"
+#include "UkkonenSuffixTree.h"
+#include "WordSuffixTree.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Benchmark de memoria: cuenta reservas del heap reemplazando el operator new
+// global y mide el pico de RSS. Cada (n, motor) corre en un proceso hijo para
+// que el pico de RSS no arrastre corridas anteriores. Escribe
+// benchmark_memory.txt con el mismo escalon de tamanos que benchmark.cpp.
+// Uso: ./memory [n] mide solo ese tamano (por ejemplo la Biblia completa).
+// "sparse" indexa solo los inicios de palabra y "word" se construye sobre
+// ids de palabra; ambos se comparan contra "lcp". "lcp40" y "lcp64" son el
+// mismo arbol con posiciones de 40 y 64 bits, y los motores con sufijo "64"
+// usan int64_t (para textos de mas de 2 o 4 GB). "folded_pair" es
+// la forma vieja de buscar sin distinguir mayusculas (un arbol sobre el texto
+// y otro sobre una copia en minusculas) y "normalized" el arbol unico sobre la
+// vista normalizada con su mapa de posiciones.
+
+// CONTEO DE RESERVAS
+
+static long long g_allocs = 0;
+static long long g_live = 0;
+static long long g_peak = 0;
+
+static void *counted_alloc(size_t sz) {
+    void *p = malloc(sz ? sz : 1);
+    if (!p)
+        throw bad_alloc();
+    g_allocs++;
+    g_live += malloc_usable_size(p);
+    g_peak = max(g_peak, g_live);
+    return p;
+}
+
+static void counted_free(void *p) {
+    if (!p)
+        return;
+    g_live -= malloc_usable_size(p);
+    free(p);
+}
+
+void *operator new(size_t sz) { return counted_alloc(sz); }
+void *operator new[](size_t sz) { return counted_alloc(sz); }
+void operator delete(void *p) noexcept { counted_free(p); }
+void operator delete[](void *p) noexcept { counted_free(p); }
+void operator delete(void *p, size_t) noexcept { counted_free(p); }
+void operator delete[](void *p, size_t) noexcept { counted_free(p); }
+
+long long peak_rss_kb() {
+    ifstream in("/proc/self/status");
+    string line;
+    while (getline(in, line))
+        if (line.rfind("VmHWM:", 0) == 0)
+            return atoll(line.c_str() + 6);
+    return -1;
+}
+
+// Dos LcpSuffixTree: el texto tal cual y una copia en minusculas.
+struct FoldedPair {
+    LcpSuffixTree exact, folded;
+
+    FoldedPair() = default;
+    explicit FoldedPair(const string &text) { build(text); }
+
+    void build(string text) {
+        string lower = text;
+        for (char &c : lower)
+            c = (char)tolower((unsigned char)c);
+        exact.build(move(text));
+        folded.build(move(lower));
+    }
+
+    bool contains(string_view P) const { return folded.contains(P); }
+    vector<uint32_t> findAll(string_view P) const { return folded.findAll(P); }
+    int countAll(string_view P) const { return folded.countAll(P); }
+    vector<uint32_t> toSuffixArray() const { return exact.toSuffixArray(); }
+
+    NodeCounts nodeCounts() const {
+        NodeCounts a = exact.nodeCounts(), b = folded.nodeCounts();
+        return {a.internal + b.internal, a.leaves + b.leaves, a.buckets + b.buckets};
+    }
+};
+
+// MEDICION
+
+template <SuffixIndex Tree> unique_ptr<Tree> build_tree(const string &txt) { return make_unique<Tree>(txt); }
+
+template <SuffixIndex Tree> string measure(const string &txt, const string &engine) {
+    long long allocs0 = g_allocs, live0 = g_live;
+    g_peak = g_live;
+
+    auto t0 = chrono::steady_clock::now();
+    auto tree = build_tree<Tree>(txt);
+    long long ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - t0).count();
+
+    long long allocs = g_allocs - allocs0;
+    long long bytes = g_live - live0;
+    long long peak = g_peak - live0;
+    auto c = tree->nodeCounts();
+
+    char line[256];
+    snprintf(line, sizeof(line), "%d,%s,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%.2f,%lld\n", (int)txt.size(), engine.c_str(),
+             c.internal, c.leaves, c.buckets, allocs, bytes, peak, peak_rss_kb(), (double)bytes / txt.size(), ms);
+    return line;
+}
+
+// Corre measure en un hijo y devuelve su linea CSV por un pipe.
+template <SuffixIndex Tree> string measure_isolated(const string &txt, const string &engine) {
+    int fd[2];
+    if (pipe(fd) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fd[0]);
+        string line = measure<Tree>(txt, engine);
+        ssize_t w = write(fd[1], line.data(), line.size());
+        _exit(w == (ssize_t)line.size() ? 0 : 1);
+    }
+
+    close(fd[1]);
+    string line;
+    char buf[256];
+    ssize_t r;
+    while ((r = read(fd[0], buf, sizeof(buf))) > 0)
+        line.append(buf, r);
+    close(fd[0]);
+    waitpid(pid, nullptr, 0);
+    return line;
+}
+
+int main(int argc, char **argv) {
+    vector<int> T = {100, 2500, 5000, 7500, 10000, 15000, 20000, 25000, 30000, 35000, 40000, 45000, 50000};
+    if (argc > 1)
+        T = {atoi(argv[1])};
+
+    cout << "Ejecutando benchmark de memoria...\n";
+
+    ofstream out("benchmark_memory.txt");
+    out << "n,engine,internal,leaves,buckets,allocs,bytes,peak_bytes,peak_rss_kb,bytes_per_char,build_ms\n";
+
+    for (int n : T) {
+        string txt = loadText("Bible.txt", n);
+        out << measure_isolated<NaiveSuffixTree>(txt, "naive");
+        out << measure_isolated<NaiveSuffixTree64>(txt, "naive64");
+        out << measure_isolated<McCreightSuffixTree>(txt, "mccreight");
+        out << measure_isolated<McCreightSuffixTree64>(txt, "mccreight64");
+        out << measure_isolated<UkkonenSuffixTree>(txt, "ukkonen");
+        out << measure_isolated<UkkonenSuffixTree64>(txt, "ukkonen64");
+        out << measure_isolated<LcpSuffixTree>(txt, "lcp");
+        out << measure_isolated<LcpSuffixTree40>(txt, "lcp40");
+        out << measure_isolated<LcpSuffixTree64>(txt, "lcp64");
+        out << measure_isolated<SparseSuffixTree>(txt, "sparse");
+        out << measure_isolated<WordSuffixTree>(txt, "word");
+        out << measure_isolated<FoldedPair>(txt, "folded_pair");
+        out << measure_isolated<NormalizedSuffixTree<>>(txt, "normalized");
+    }
+
+    cout << "Listo. Guardado en benchmark_memory.txt\n";
+    return 0;
+}
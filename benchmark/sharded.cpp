@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "ShardedIndex.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Indice partido en shards (hilos o procesos) contra un solo LcpSuffixTree.
+// Para 1, 2, 4 y 8 shards mide la construccion y el rendimiento de contains,
+// countAll y findAll, y verifica cada respuesta contra el arbol unico.
+// Escribe benchmark_sharded.txt:
+//   mode,shards,chars,build_ms,contains_qps,countAll_qps,findAll_qps,ok
+// Uso: ./sharded [n] [max_patron]
+
+long long now_us() { return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    size_t maxPattern = argc > 2 ? atoi(argv[2]) : 32;
+
+    string text = loadText("Bible.txt", n);
+    mt19937 rng(7);
+    vector<string> P;
+    for (int q = 0; q < 2000; q++) {
+        size_t len = 1 + rng() % maxPattern;
+        string p = text.substr(rng() % (text.size() - 1 - len), len);
+        if (q % 4 == 3)
+            p.back() ^= 1;
+        P.push_back(p);
+    }
+
+    // respuestas esperadas (posiciones globales ordenadas)
+    LcpSuffixTree whole(text);
+    vector<vector<uint64_t>> expected;
+    for (const string &p : P) {
+        auto v = whole.findAll(p);
+        vector<uint64_t> g(v.begin(), v.end());
+        sort(g.begin(), g.end());
+        expected.push_back(g);
+    }
+
+    ofstream out("benchmark_sharded.txt");
+    out << "mode,shards,chars,build_ms,contains_qps,countAll_qps,findAll_qps,ok\n";
+
+    using Index = ShardedIndex<LcpSuffixTree>;
+    for (auto mode : {Index::Mode::Threads, Index::Mode::Processes}) {
+        const char *name = mode == Index::Mode::Threads ? "threads" : "processes";
+        for (int shards : {1, 2, 4, 8}) {
+            long long t0 = now_us();
+            Index idx(text, shards, maxPattern, mode);
+            idx.contains(P[0]); // los procesos hijos construyen en segundo plano: esperarlos
+            long long buildMs = (now_us() - t0) / 1000;
+
+            bool ok = true;
+            auto qps = [&](auto &&query) {
+                long long t = now_us();
+                for (size_t i = 0; i < P.size(); i++)
+                    ok = query(i) && ok;
+                return (long long)(P.size() * 1e6 / max(1LL, now_us() - t));
+            };
+            long long qContains = qps([&](size_t i) { return idx.contains(P[i]) == !expected[i].empty(); });
+            long long qCount = qps([&](size_t i) { return idx.countAll(P[i]) == expected[i].size(); });
+            long long qFind = qps([&](size_t i) { return idx.findAll(P[i]) == expected[i]; });
+            string tooLong(maxPattern + 1, 'a'); // se rechaza sin tirar abajo el proceso
+            ok = ok && !idx.accepts(tooLong) && idx.countAll(tooLong) == 0 && idx.findAll(tooLong).empty();
+
+            out << name << "," << shards << "," << text.size() << "," << buildMs << "," << qContains << "," << qCount
+                << "," << qFind << "," << ok << "\n";
+            cout << name << " shards=" << shards << ": " << buildMs << " ms, " << qContains << " / " << qCount << " / "
+                 << qFind << " consultas/s" << (ok ? "" : "  ERROR: no coincide con el arbol unico") << "\n";
+        }
+    }
+
+    cout << "Listo. Guardado en benchmark_sharded.txt\n";
+    return 0;
+}
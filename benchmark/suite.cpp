@@ -0,0 +1,486 @@
+#include <pthread.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "McCreightSuffixTree.h"
+#include "NaiveSuffixTree.h"
+#include "QueryCache.h"
+#include "UkkonenSuffixTree.h"
+#include "WordSuffixTree.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Suite de construccion y consultas sobre varios corpus. Escribe una fila CSV
+// por (corpus, motor, carga) en benchmark_suite.txt:
+//   corpus,n,engine,workload,ops,p50_ns,p99_ns,mean_ns,qps
+// Uso: ./suite [n] [consultas] [repeticiones] [hilos]
+// El costo en memoria de la tabla de k-mers va a benchmark_jump.txt y el del
+// filtro de q-gramas (con sus falsos negativos, que deben ser 0) a
+// benchmark_filter.txt. Las frases de 2 a 5 palabras sobre la Biblia comparan
+// el arbol de palabras con los de caracteres (carga "phrase"). Las cargas
+// "_zipf" repiten patrones con distribucion de Zipf, con y sin QueryCache
+// (contadores del cache en benchmark_cache.txt). Las cargas "_parallel"
+// reparten findAll de patrones muy frecuentes y toSuffixArray en [hilos]
+// (su escalado con 1, 2, 4, ... hilos, con el speedup contra 1 hilo, va a
+// benchmark_scaling.txt); "contains_batch" resuelve todo el lote con
+// containsBatch. Las cargas "_range" piden las ocurrencias frecuentes dentro
+// de un tramo del texto y "exportArrays_" sacan SA (y LCP, BWT e ISA) en un
+// solo recorrido.
+
+struct Config {
+    int n = 100000;
+    int queries = 1000;
+    int trials = 3;
+    int warmup = 1;
+    double filterBytesPerChar = 1.0; // presupuesto del filtro de q-gramas
+    int threads = (int)thread::hardware_concurrency();
+};
+
+long long now_ns() { return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+// CORPUS
+
+string bible_corpus(int n) {
+    ifstream in("Bible.txt");
+    if (!in.is_open()) {
+        cerr << "Error: no se pudo abrir Bible.txt\n";
+        exit(1);
+    }
+    string text((istreambuf_iterator<char>(in)), {});
+    if ((int)text.size() > n)
+        text.resize(n);
+    return text;
+}
+
+string random_corpus(int n, const string &alphabet, unsigned seed) {
+    mt19937 rng(seed);
+    string t(n, ' ');
+    for (char &c : t)
+        c = alphabet[rng() % alphabet.size()];
+    return t;
+}
+
+string fibonacci_corpus(int n) {
+    string prev = "b", t = "a";
+    while ((int)t.size() < n) {
+        string nxt = t + prev;
+        prev = t;
+        t = nxt;
+    }
+    t.resize(n);
+    return t;
+}
+
+struct Corpus {
+    string name;
+    string text;
+    bool adversarial; // el naive es cuadratico aqui, se omite
+    int jumpK;        // k de la tabla de salto en la raiz
+    int filterQ;      // q del filtro de q-gramas
+};
+
+vector<Corpus> make_corpora(int n) {
+    return {
+        {"bible", bible_corpus(n), false, 3, 4},
+        {"random", random_corpus(n, "abcdefghijklmnopqrstuvwxyz", 1), false, 3, 4},
+        {"dna", random_corpus(n, "ACGT", 2), false, 10, 10},
+        {"repetitive", string(n, 'a'), true, 3, 3},
+        {"fibonacci", fibonacci_corpus(n), true, 3, 8},
+    };
+}
+
+// Mitad subcadenas del texto (aciertos) y mitad cadenas al azar sobre el
+// alfabeto del corpus (en su mayoria fallos).
+// hitEvery = 2 da la mezcla por defecto; hitEvery = 0 solo cadenas al azar
+// (carga dominada por fallos).
+vector<string> make_patterns(const string &text, int count, unsigned seed, int hitEvery = 2) {
+    mt19937 rng(seed);
+    string alphabet = text;
+    sort(alphabet.begin(), alphabet.end());
+    alphabet.erase(unique(alphabet.begin(), alphabet.end()), alphabet.end());
+
+    vector<string> P;
+    for (int q = 0; q < count; q++) {
+        int len = 3 + rng() % 10;
+        if (hitEvery > 0 && q % hitEvery == 0) {
+            int pos = rng() % (text.size() - len);
+            P.push_back(text.substr(pos, len));
+        } else {
+            string p(len, ' ');
+            for (char &c : p)
+                c = alphabet[rng() % alphabet.size()];
+            P.push_back(p);
+        }
+    }
+    return P;
+}
+
+// Frases de 2 a 5 palabras copiadas del texto, empezando en un inicio de palabra.
+vector<string> make_phrases(const string &text, int count, unsigned seed) {
+    mt19937 rng(seed);
+    vector<int> starts = wordStarts(text);
+    vector<string> P;
+    while ((int)P.size() < count && !starts.empty()) {
+        size_t w = rng() % starts.size();
+        size_t last = w + 1 + rng() % 4;
+        if (last >= starts.size())
+            continue;
+        int end = starts[last];
+        while (end > starts[w] && isWordSeparator(text[end - 1]))
+            end--;
+        P.push_back(text.substr(starts[w], end - starts[w]));
+    }
+    return P;
+}
+
+// Los count patrones de 1 y 2 caracteres con mas ocurrencias (resultados de
+// cientos de miles de posiciones en textos grandes).
+vector<string> make_frequent(const string &text, int count) {
+    vector<long long> freq(256 * 257, 0);
+    for (size_t i = 0; i < text.size(); i++) {
+        freq[(unsigned char)text[i]]++;
+        if (i + 1 < text.size())
+            freq[256 + (unsigned char)text[i] * 256 + (unsigned char)text[i + 1]]++;
+    }
+    vector<int> ids(freq.size());
+    for (size_t i = 0; i < ids.size(); i++)
+        ids[i] = (int)i;
+    sort(ids.begin(), ids.end(), [&](int a, int b) { return freq[a] > freq[b]; });
+
+    vector<string> P;
+    for (int id : ids) {
+        if ((int)P.size() == count || freq[id] == 0)
+            break;
+        if (id < 256)
+            P.push_back(string(1, (char)id));
+        else
+            P.push_back({(char)((id - 256) / 256), (char)((id - 256) % 256)});
+    }
+    return P;
+}
+
+// count consultas tomadas de P con probabilidad ~ 1 / rango (Zipf, s = 1).
+vector<string> make_zipf(const vector<string> &P, int count, unsigned seed) {
+    vector<double> w(P.size());
+    for (size_t r = 0; r < P.size(); r++)
+        w[r] = 1.0 / (r + 1);
+    discrete_distribution<size_t> pick(w.begin(), w.end());
+    mt19937 rng(seed);
+
+    vector<string> Q;
+    for (int q = 0; q < count; q++)
+        Q.push_back(P[pick(rng)]);
+    return Q;
+}
+
+// MEDICION
+
+volatile long long sink; // evita que se eliminen las consultas
+
+struct Row {
+    string corpus, engine, workload;
+    int n;
+    vector<long long> lat;
+    long long total;
+};
+
+void write_row(ostream &out, Row &r) {
+    sort(r.lat.begin(), r.lat.end());
+    size_t m = r.lat.size();
+    long long sum = 0;
+    for (long long x : r.lat)
+        sum += x;
+    long long p50 = r.lat[m / 2];
+    long long p99 = r.lat[min(m - 1, (size_t)(m * 0.99))];
+    double qps = r.total > 0 ? m * 1e9 / r.total : 0;
+
+    out << r.corpus << "," << r.n << "," << r.engine << "," << r.workload << "," << m << "," << p50 << "," << p99 << ","
+        << sum / (long long)m << "," << (long long)qps << "\n";
+    cout << "  " << r.engine << " " << r.workload << ": p50 " << p50 << " ns, p99 " << p99 << " ns\n";
+}
+
+// Latencia de query(p) para cada p de Q, cfg.trials veces.
+template <class Query>
+void measure_queries(ostream &out, const Config &cfg, const Corpus &C, const string &engine, const string &workload,
+                     const vector<string> &Q, Query &&query) {
+    Row r{C.name, engine, workload, (int)C.text.size(), {}, 0};
+    for (int w = 0; w < cfg.warmup; w++)
+        for (const string &p : Q)
+            sink = query(p);
+
+    r.lat.reserve(Q.size() * cfg.trials);
+    for (int t = 0; t < cfg.trials; t++) {
+        long long start = now_ns();
+        for (const string &p : Q) {
+            long long t0 = now_ns();
+            sink = query(p);
+            r.lat.push_back(now_ns() - t0);
+        }
+        r.total += now_ns() - start;
+    }
+    write_row(out, r);
+}
+
+template <SuffixIndex Tree> unique_ptr<Tree> build_tree(const string &txt) { return make_unique<Tree>(txt); }
+
+// Un archivo por tabla; el constructor escribe las cabeceras.
+struct Outputs {
+    ofstream suite{"benchmark_suite.txt"};
+    ofstream jump{"benchmark_jump.txt"};
+    ofstream filter{"benchmark_filter.txt"};
+    ofstream cache{"benchmark_cache.txt"};
+    ofstream scaling{"benchmark_scaling.txt"};
+
+    Outputs() {
+        suite << "corpus,n,engine,workload,ops,p50_ns,p99_ns,mean_ns,qps\n";
+        jump << "corpus,n,engine,k,bytes,bytes_per_char\n";
+        filter << "corpus,n,engine,q,bytes,false_negatives,rejected_fraction\n";
+        cache << "corpus,n,engine,bytes,count_hits,count_misses,list_hits,list_misses,count_evictions,list_evictions,"
+                 "rejected\n";
+        scaling << "corpus,n,engine,workload,threads,mean_ns,speedup\n";
+    }
+};
+
+template <SuffixIndex Tree>
+void bench_engine(Outputs &o, ThreadPool &workers, const Config &cfg, const Corpus &C, const string &engine,
+                  const vector<string> &P, const vector<string> &miss) {
+    Row build{C.name, engine, "build", (int)C.text.size(), {}, 0};
+    for (int w = 0; w < cfg.warmup; w++)
+        build_tree<Tree>(C.text);
+    for (int t = 0; t < cfg.trials; t++) {
+        long long t0 = now_ns();
+        auto tree = build_tree<Tree>(C.text);
+        long long dt = now_ns() - t0;
+        build.lat.push_back(dt);
+        build.total += dt;
+    }
+    write_row(o.suite, build);
+
+    auto tree = build_tree<Tree>(C.text);
+
+    auto runOn = [&](const vector<string> &Q, const string &workload, auto &&query) {
+        measure_queries(o.suite, cfg, C, engine, workload, Q, query);
+    };
+    auto run = [&](const string &workload, auto &&query) { runOn(P, workload, query); };
+
+    run("contains", [&](const string &p) { return (long long)tree->contains(p); });
+
+    // el mismo lote con recorridos intercalados; la latencia es la amortizada
+    Row batch{C.name, engine, "contains_batch", (int)C.text.size(), {}, 0};
+    for (int w = 0; w < cfg.warmup; w++)
+        sink = tree->containsBatch(P).size();
+    for (int t = 0; t < cfg.trials; t++) {
+        long long t0 = now_ns();
+        sink = tree->containsBatch(P).size();
+        long long dt = now_ns() - t0;
+        batch.lat.insert(batch.lat.end(), P.size(), dt / (long long)P.size());
+        batch.total += dt;
+    }
+    write_row(o.suite, batch);
+
+    run("findAll", [&](const string &p) { return (long long)tree->findAll(p).size(); });
+    run("countAll", [&](const string &p) { return (long long)tree->countAll(p); });
+
+    // las mismas consultas saltando los primeros k niveles
+    int k = tree->enableJumpTable(C.jumpK);
+    o.jump << C.name << "," << C.text.size() << "," << engine << "," << k << "," << tree->jumpTableBytes() << ","
+            << (double)tree->jumpTableBytes() / C.text.size() << "\n";
+    run("contains_jump", [&](const string &p) { return (long long)tree->contains(p); });
+    run("countAll_jump", [&](const string &p) { return (long long)tree->countAll(p); });
+    tree->disableJumpTable();
+
+    // carga de fallos con y sin el filtro de q-gramas
+    vector<char> expected;
+    for (const vector<string> *Q : {&P, &miss})
+        for (const string &p : *Q)
+            expected.push_back(tree->contains(p));
+    runOn(miss, "contains_miss", [&](const string &p) { return (long long)tree->contains(p); });
+
+    tree->enableFilter(C.filterQ, (size_t)(cfg.filterBytesPerChar * C.text.size()));
+    long long falseNeg = 0, rejected = 0, absent = 0;
+    size_t e = 0;
+    for (const vector<string> *Q : {&P, &miss}) {
+        for (const string &p : *Q) {
+            bool may = tree->mayContain(p);
+            if (expected[e] && (!may || !tree->contains(p)))
+                falseNeg++;
+            if (!expected[e]) {
+                absent++;
+                rejected += !may;
+            }
+            e++;
+        }
+    }
+    o.filter << C.name << "," << C.text.size() << "," << engine << "," << C.filterQ << "," << tree->filterBytes() << ","
+              << falseNeg << "," << (absent ? (double)rejected / absent : 0.0) << "\n";
+    if (falseNeg)
+        cerr << "Error: el filtro rechazo " << falseNeg << " patrones presentes\n";
+    runOn(miss, "contains_miss_filter", [&](const string &p) { return (long long)tree->contains(p); });
+    tree->disableFilter();
+
+    // trafico sesgado: los mismos pocos patrones se repiten
+    vector<string> zipf = make_zipf(P, (int)P.size(), 17);
+    runOn(zipf, "findAll_zipf", [&](const string &p) { return (long long)tree->findAll(p).size(); });
+    runOn(zipf, "countAll_zipf", [&](const string &p) { return (long long)tree->countAll(p); });
+    QueryCache<Tree> cache(*tree, 1 << 12, 16 << 20);
+    runOn(zipf, "findAll_zipf_cached", [&](const string &p) { return (long long)cache.findAll(p)->size(); });
+    runOn(zipf, "countAll_zipf_cached", [&](const string &p) { return (long long)cache.countAll(p); });
+    const CacheStats &cs = cache.stats();
+    o.cache << C.name << "," << C.text.size() << "," << engine << "," << cache.bytes() << "," << cs.countHits << ","
+             << cs.countMisses << "," << cs.listHits << "," << cs.listMisses << "," << cs.countEvictions << ","
+             << cs.listEvictions << "," << cs.rejected << "\n";
+
+    // resultados enormes: recorrido secuencial contra repartido en hilos
+    vector<string> frequent = make_frequent(C.text, 8);
+    runOn(frequent, "findAll_frequent", [&](const string &p) { return (long long)tree->findAll(p).size(); });
+    runOn(frequent, "findAll_frequent_parallel", [&](const string &p) { return (long long)tree->findAll(p, workers).size(); });
+
+    // las mismas dentro de un tramo del 2% del texto (un "libro"): filtrando
+    // el recorrido completo contra la wavelet matrix de enableRangeQueries
+    uint64_t lo = C.text.size() / 2, hi = lo + C.text.size() / 50;
+    runOn(frequent, "findAll_range_filtered", [&](const string &p) { return (long long)tree->findAll(p, lo, hi).size(); });
+    tree->enableRangeQueries();
+    runOn(frequent, "findAll_range", [&](const string &p) { return (long long)tree->findAll(p, lo, hi).size(); });
+    runOn(frequent, "countAll_range", [&](const string &p) { return (long long)tree->countAll(p, lo, hi); });
+    tree->disableRangeQueries();
+
+    auto bench_sa = [&](const string &workload, auto &&toSA) {
+        Row sa{C.name, engine, workload, (int)C.text.size(), {}, 0};
+        for (int w = 0; w < cfg.warmup; w++)
+            sink = toSA().size();
+        for (int t = 0; t < cfg.trials; t++) {
+            long long t0 = now_ns();
+            sink = toSA().size();
+            long long dt = now_ns() - t0;
+            sa.lat.push_back(dt);
+            sa.total += dt;
+        }
+        write_row(o.suite, sa);
+    };
+    bench_sa("toSuffixArray", [&] { return tree->toSuffixArray(); });
+    bench_sa("toSuffixArray_parallel", [&] { return tree->toSuffixArray(workers); });
+
+    // escalado: las cargas "_parallel" con 1, 2, 4, ... hilos hasta [hilos]
+    vector<int> counts;
+    for (int t = 1; t < cfg.threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(max(1, cfg.threads));
+    double base[2] = {0, 0};
+    for (int t : counts) {
+        ThreadPool pool(t);
+        auto mean_ns = [&](auto &&run) {
+            run();
+            long long t0 = now_ns();
+            for (int r = 0; r < cfg.trials; r++)
+                run();
+            return (double)(now_ns() - t0) / cfg.trials;
+        };
+        double ns[2] = {mean_ns([&] {
+                            for (const string &p : frequent)
+                                sink = tree->findAll(p, pool).size();
+                        }),
+                        mean_ns([&] { sink = tree->toSuffixArray(pool).size(); })};
+        const char *names[2] = {"findAll_frequent_parallel", "toSuffixArray_parallel"};
+        for (int k = 0; k < 2; k++) {
+            if (t == 1)
+                base[k] = ns[k];
+            o.scaling << C.name << "," << C.text.size() << "," << engine << "," << names[k] << "," << t << ","
+                       << (long long)ns[k] << "," << base[k] / ns[k] << "\n";
+        }
+    }
+
+    // SA + LCP: toSuffixArray y Kasai contra un solo recorrido a buffers fijos
+    bench_sa("toSuffixArray_lcp", [&] { return buildLcp(tree->s, tree->toSuffixArray()); });
+    size_t m = tree->s.size();
+    vector<typename Tree::Pos> SA(m), LCP(m), ISA(m);
+    string BWT(m, 0);
+    bench_sa("exportArrays_sa", [&] { return span(SA.data(), tree->exportArrays(SA.data(), nullptr, nullptr, nullptr)); });
+    bench_sa("exportArrays_all",
+             [&] { return span(SA.data(), tree->exportArrays(SA.data(), LCP.data(), BWT.data(), ISA.data())); });
+}
+
+template <SuffixIndex Tree>
+void bench_phrases(ostream &out, const Config &cfg, const Corpus &C, const string &engine, const vector<string> &P) {
+    auto tree = build_tree<Tree>(C.text);
+    cout << "  " << engine << ": " << tree->nodeCounts().internal + tree->nodeCounts().leaves << " nodos\n";
+    measure_queries(out, cfg, C, engine, "phrase", P, [&](const string &p) { return (long long)tree->contains(p); });
+    measure_queries(out, cfg, C, engine, "phrase_findAll", P,
+                    [&](const string &p) { return (long long)tree->findAll(p).size(); });
+}
+
+void *run_suite(void *arg) {
+    const Config &cfg = *(const Config *)arg;
+
+    Outputs o;
+    ThreadPool workers(cfg.threads);
+    cout << workers.size() << " hilos\n";
+
+    for (Corpus &C : make_corpora(cfg.n)) {
+        if (C.text.empty() || C.text.back() != '$')
+            C.text.push_back('$');
+        cout << C.name << " (" << C.text.size() << " caracteres)\n";
+
+        string body = C.text.substr(0, C.text.size() - 1);
+        vector<string> P = make_patterns(body, cfg.queries, 7);
+        vector<string> miss = make_patterns(body, cfg.queries, 11, 0);
+        if (!C.adversarial)
+            bench_engine<NaiveSuffixTree>(o, workers, cfg, C, "naive", P, miss);
+        bench_engine<McCreightSuffixTree>(o, workers, cfg, C, "mccreight", P, miss);
+        bench_engine<UkkonenSuffixTree>(o, workers, cfg, C, "ukkonen", P, miss);
+        bench_engine<LcpSuffixTree>(o, workers, cfg, C, "lcp", P, miss);
+
+        if (C.name == "bible") {
+            Row build{C.name, "word", "build", (int)C.text.size(), {}, 0};
+            for (int t = 0; t < cfg.trials; t++) {
+                long long t0 = now_ns();
+                build_tree<WordSuffixTree>(C.text);
+                long long dt = now_ns() - t0;
+                build.lat.push_back(dt);
+                build.total += dt;
+            }
+            write_row(o.suite, build);
+
+            vector<string> phrases = make_phrases(body, cfg.queries, 13);
+            bench_phrases<UkkonenSuffixTree>(o.suite, cfg, C, "ukkonen", phrases);
+            bench_phrases<LcpSuffixTree>(o.suite, cfg, C, "lcp", phrases);
+            bench_phrases<WordSuffixTree>(o.suite, cfg, C, "word", phrases);
+        }
+    }
+    return nullptr;
+}
+
+int main(int argc, char **argv) {
+    Config cfg;
+    if (argc > 1)
+        cfg.n = atoi(argv[1]);
+    if (argc > 2)
+        cfg.queries = atoi(argv[2]);
+    if (argc > 3)
+        cfg.trials = atoi(argv[3]);
+    if (argc > 4)
+        cfg.threads = atoi(argv[4]);
+
+    // En los corpus repetitivos el arbol tiene profundidad ~n y los recorridos
+    // recursivos (DFS, toSuffixArray) necesitan mas pila que la por defecto.
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, (size_t)1 << 30);
+    pthread_t th;
+    pthread_create(&th, &attr, run_suite, &cfg);
+    pthread_join(th, nullptr);
+    pthread_attr_destroy(&attr);
+
+    cout << "Listo. Guardado en benchmark_suite.txt\n";
+    return 0;
+}
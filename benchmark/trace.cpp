@@ -0,0 +1,80 @@
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "UkkonenSuffixTree.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Latencia y trabajo por consulta con SUFFIX_TREE_TRACE (este ejecutable se
+// compila siempre con la bandera). Patrones tomados del texto, de 2 a 12
+// caracteres, mas uno de cada cuatro alterado para que no aparezca. Imprime
+// el volcado de QueryTrace y escribe benchmark_trace.txt:
+//   engine,method,calls,p50_ns,p90_ns,p99_ns,max_ns,nodes,edge_chars,leaves,map_probes,
+//   nodes_p50,nodes_p99,edge_chars_p50,edge_chars_p99,leaves_p50,leaves_p99,map_probes_p50,map_probes_p99
+// (trabajo medio por consulta y sus percentiles por consulta).
+// Uso: ./trace [n] [consultas]
+
+vector<string> makePatterns(const string &s, int q) {
+    mt19937_64 rng(42);
+    vector<string> res;
+    for (int i = 0; i < q; i++) {
+        size_t len = 2 + rng() % 11;
+        string p = s.substr(rng() % (s.size() - len), len);
+        if (i % 4 == 3)
+            p.back() = '#';
+        res.push_back(p);
+    }
+    return res;
+}
+
+template <class Tree> void bench(ofstream &out, Tree &tree, const string &engine, const vector<string> &patterns) {
+    tree.enableQueryTrace();
+    long long sink = 0;
+    for (const string &p : patterns) {
+        sink += tree.contains(p);
+        sink += tree.countAll(p);
+        sink += tree.findAll(p).size();
+    }
+
+    QueryTrace tr = tree.queryTrace();
+    cout << engine << " (" << sink << ")\n";
+    tr.dump(cout);
+    for (int m = 0; m < QueryTrace::kMethods; m++) {
+        const MethodTrace &t = tr.methods[m];
+        double n = (double)t.latencyNs.count();
+        if (n == 0)
+            continue;
+        out << engine << "," << QueryTrace::kNames[m] << "," << t.latencyNs.count() << ","
+            << t.latencyNs.percentile(0.5) << "," << t.latencyNs.percentile(0.9) << "," << t.latencyNs.percentile(0.99)
+            << "," << t.latencyNs.max() << "," << t.work.nodesVisited / n << "," << t.work.edgeChars / n << ","
+            << t.work.leaves / n << "," << t.work.mapProbes / n;
+        for (const LatencyHistogram *h :
+             {&t.perQuery.nodesVisited, &t.perQuery.edgeChars, &t.perQuery.leaves, &t.perQuery.mapProbes})
+            out << "," << h->percentile(0.5) << "," << h->percentile(0.99);
+        out << "\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    long long n = argc > 1 ? atoll(argv[1]) : 1000000;
+    int q = argc > 2 ? atoi(argv[2]) : 20000;
+
+    string text = loadText("Bible.txt", n);
+    vector<string> patterns = makePatterns(text, q);
+
+    ofstream out("benchmark_trace.txt");
+    out << "engine,method,calls,p50_ns,p90_ns,p99_ns,max_ns,nodes,edge_chars,leaves,map_probes,nodes_p50,nodes_p99,"
+           "edge_chars_p50,edge_chars_p99,leaves_p50,leaves_p99,map_probes_p50,map_probes_p99\n";
+    LcpSuffixTree lcp(text);
+    bench(out, lcp, "lcp", patterns);
+    UkkonenSuffixTree ukkonen(text);
+    bench(out, ukkonen, "ukkonen", patterns);
+
+    cout << "Listo. Guardado en benchmark_trace.txt\n";
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "UkkonenSuffixTree.h"
+#include "WildcardPattern.h"
+
+using namespace std;
+using namespace suffixtree;
+
+// Patrones con comodines, clases y huecos acotados sobre la Biblia: recorrido
+// del arbol (forEachWildcardMatch) contra un barrido lineal del texto con el
+// mismo automato desde cada posicion. Verifica que den las mismas posiciones.
+// Escribe benchmark_wildcard.txt:
+//   pattern,n,engine,matches,tree_us,scan_us,ok
+// Uso: ./wildcard [n] [repeticiones]
+
+long long now_us() { return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count(); }
+
+vector<long long> scan(const string &s, const WildcardPattern &pat) {
+    vector<long long> res;
+    size_t n = s.size() - 1; // sin el '$'
+    for (size_t i = 0; i <= n; i++) {
+        uint64_t S = pat.start();
+        for (size_t j = i; !pat.accepts(S) && S && j < n; j++)
+            S = pat.step(S, (unsigned char)s[j]);
+        if (pat.accepts(S))
+            res.push_back((long long)i);
+    }
+    return res;
+}
+
+template <class Tree>
+void bench(ofstream &out, const Tree &tree, const string &engine, const vector<string> &patterns, int reps) {
+    for (const string &p : patterns) {
+        WildcardPattern pat;
+        if (!pat.compile(p)) {
+            cerr << "Error: patron invalido " << p << "\n";
+            exit(1);
+        }
+
+        long long t0 = now_us();
+        vector<long long> hits;
+        for (int r = 0; r < reps; r++) {
+            auto v = findAllWildcard(tree, pat);
+            hits.assign(v.begin(), v.end());
+        }
+        long long treeUs = (now_us() - t0) / reps;
+
+        t0 = now_us();
+        vector<long long> expected;
+        for (int r = 0; r < reps; r++)
+            expected = scan(tree.s, pat);
+        long long scanUs = (now_us() - t0) / reps;
+
+        sort(hits.begin(), hits.end());
+        bool ok = hits == expected;
+        out << "\"" << p << "\"," << tree.s.size() << "," << engine << "," << hits.size() << "," << treeUs << "," << scanUs
+            << "," << ok << "\n";
+        cout << engine << " " << p << ": " << hits.size() << " ocurrencias, arbol " << treeUs << " us, barrido " << scanUs
+             << " us" << (ok ? "" : "  ERROR: no coincide con el barrido") << "\n";
+    }
+}
+
+int main(int argc, char **argv) {
+    long long n = argc > 1 ? atoll(argv[1]) : 1LL << 62;
+    int reps = argc > 2 ? atoi(argv[2]) : 3;
+
+    string text = loadText("Bible.txt", n);
+    vector<string> patterns = {"L?rd",        "[Gg]od said", "the [A-Z]?{2,5} of", "s[aeiou]{2}d", "?{2}ord",
+                               "[^a-z ]{3}", "And ?{1,6} said", "b[aeiou][a-z]{0,2}n"};
+
+    ofstream out("benchmark_wildcard.txt");
+    out << "pattern,n,engine,matches,tree_us,scan_us,ok\n";
+    bench(out, LcpSuffixTree(text), "lcp", patterns, reps);
+    bench(out, UkkonenSuffixTree(text), "ukkonen", patterns, reps);
+
+    cout << "Listo. Guardado en benchmark_wildcard.txt\n";
+    return 0;
+}
@@ -0,0 +1,431 @@
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace suffixtree {
+
+// Archivo de solo lectura mapeado en memoria. El sistema trae y descarta
+// paginas a demanda, asi que el archivo puede ser mas grande que la RAM.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string &path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "Error: no se pudo abrir " << path << "\n";
+            std::exit(1);
+        }
+        struct stat st;
+        fstat(fd, &st);
+        len = (size_t)st.st_size;
+        if (len > 0) {
+            void *p = mmap(nullptr, len, PROT_READ, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                perror("mmap");
+                std::exit(1);
+            }
+            ptr = (const char *)p;
+        }
+        close(fd);
+    }
+
+    MappedFile(MappedFile &&o) noexcept : ptr(std::exchange(o.ptr, nullptr)), len(std::exchange(o.len, 0)) {}
+    MappedFile &operator=(MappedFile &&o) noexcept {
+        std::swap(ptr, o.ptr);
+        std::swap(len, o.len);
+        return *this;
+    }
+    ~MappedFile() {
+        if (ptr)
+            munmap((void *)ptr, len);
+    }
+
+    const char *data() const { return ptr; }
+    size_t size() const { return len; }
+    void advise(int how) const {
+        if (ptr)
+            madvise((void *)ptr, len, how);
+    }
+
+  private:
+    const char *ptr = nullptr;
+    size_t len = 0;
+};
+
+// Lee registros de tamano fijo de un archivo, de a bloques.
+template <class T> class RecordReader {
+  public:
+    RecordReader(const std::string &path, size_t block, uint64_t skip = 0) : path(path), block(block) {
+        in.open(path, std::ios::binary);
+        if (!in.is_open()) {
+            std::cerr << "Error: no se pudo abrir " << path << "\n";
+            std::exit(1);
+        }
+        in.seekg((std::streamoff)(skip * sizeof(T)));
+    }
+
+    bool next(T &x) {
+        if (pos == buf.size() && !refill())
+            return false;
+        x = buf[pos++];
+        return true;
+    }
+
+  private:
+    std::string path;
+    std::ifstream in;
+    std::vector<T> buf;
+    size_t block, pos = 0;
+
+    bool refill() {
+        buf.resize(block);
+        in.read((char *)buf.data(), block * sizeof(T));
+        if (in.bad() || in.gcount() % sizeof(T) != 0) {
+            std::cerr << "Error: no se pudo leer " << path << "\n";
+            std::exit(1);
+        }
+        buf.resize(in.gcount() / sizeof(T));
+        pos = 0;
+        return !buf.empty();
+    }
+};
+
+// Escribe registros de tamano fijo de a bloques. Cualquier error de escritura
+// (por ejemplo, disco lleno) termina el programa: un arreglo truncado no se
+// distingue de uno valido.
+template <class T> class RecordWriter {
+  public:
+    RecordWriter(const std::string &path, size_t block) : path(path), block(block) {
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Error: no se pudo crear " << path << "\n";
+            std::exit(1);
+        }
+        buf.reserve(block);
+    }
+
+    ~RecordWriter() { close(); }
+
+    void push(const T &x) {
+        buf.push_back(x);
+        if (buf.size() == block)
+            flush();
+    }
+
+    void close() {
+        if (!out.is_open())
+            return;
+        flush();
+        out.close();
+        if (out.fail())
+            fail();
+    }
+
+  private:
+    std::string path;
+    std::ofstream out;
+    std::vector<T> buf;
+    size_t block;
+
+    void flush() {
+        out.write((const char *)buf.data(), buf.size() * sizeof(T));
+        if (!out.good())
+            fail();
+        buf.clear();
+    }
+
+    [[noreturn]] void fail() {
+        std::cerr << "Error: no se pudo escribir " << path << " (disco lleno?)\n";
+        std::exit(1);
+    }
+};
+
+// Arreglo de sufijos en disco para textos que no entran en memoria. El texto
+// queda tal cual en su archivo (sin '$': el fin del texto es menor que
+// cualquier caracter) y el arreglo es un archivo de uint64_t.
+//
+// Construccion por duplicacion de prefijos con ordenamiento externo (tramos
+// de a lo sumo budgetBytes ordenados en memoria, escritos como corridas y
+// mezclados):
+// 1. Las posiciones se ordenan por sus primeros kPrefix caracteres (memcmp
+//    acotado sobre el texto mapeado) y cada sufijo recibe como nombre 1 + la
+//    cantidad de sufijos con un prefijo menor.
+// 2. Mientras haya nombres repetidos, una ronda con h = kPrefix, 2 kPrefix, ...
+//    ordena las ternas (nombre[i], nombre[i + h], i) y renombra; otro
+//    ordenamiento devuelve los nombres a orden de posicion para la siguiente.
+// Los archivos se leen y escriben en forma secuencial y hay log(LCP maximo /
+// kPrefix) rondas, asi que un texto repetitivo no vuelve cuadratica la
+// construccion ni hace releer el texto una vez por tramo.
+class ExternalSuffixArray {
+  public:
+    struct BuildInfo {
+        size_t rounds = 0; // rondas de duplicacion despues del orden por prefijo
+        size_t runs = 0;   // corridas temporales que hubo que mezclar
+    };
+
+    static constexpr uint64_t kPrefix = 32;
+
+    static BuildInfo build(const std::string &textPath, const std::string &saPath, size_t budgetBytes) {
+        MappedFile text(textPath);
+        const char *t = text.data();
+        uint64_t n = text.size();
+        const std::string namesPath = saPath + ".names", pairsPath = saPath + ".pairs", runPath = saPath + ".run";
+        BuildInfo info;
+
+        // pairs: (posicion, nombre) en el orden de los sufijos
+        uint64_t distinct = 0;
+        {
+            RecordWriter<Named> pairs(pairsPath, kBlock);
+            uint64_t next = 0, k = 0, prev = 0, name = 0;
+            auto cmp = [&](uint64_t a, uint64_t b) { return comparePrefix(t, n, a, b, kPrefix); };
+            info.runs += sortStream<uint64_t>(
+                runPath, budgetBytes,
+                [&](uint64_t &x) {
+                    if (next == n)
+                        return false;
+                    x = next++;
+                    return true;
+                },
+                [&](uint64_t a, uint64_t b) { return cmp(a, b) < 0; },
+                [&](uint64_t p) {
+                    if (k == 0 || cmp(prev, p) != 0) {
+                        name = k + 1;
+                        distinct++;
+                    }
+                    pairs.push({p, name});
+                    prev = p;
+                    k++;
+                });
+        }
+
+        for (uint64_t h = kPrefix; distinct < n; h *= 2) {
+            info.rounds++;
+            {
+                RecordReader<Named> pairs(pairsPath, kBlock);
+                RecordWriter<uint64_t> names(namesPath, kBlock);
+                info.runs += sortStream<Named>(
+                    runPath, budgetBytes, [&](Named &x) { return pairs.next(x); },
+                    [](const Named &a, const Named &b) { return a.pos < b.pos; },
+                    [&](const Named &x) { names.push(x.name); });
+            }
+
+            RecordReader<uint64_t> first(namesPath, kBlock), second(namesPath, kBlock, h < n ? h : 0);
+            RecordWriter<Named> pairs(pairsPath, kBlock);
+            uint64_t i = 0, k = 0, name = 0;
+            Triple prev{};
+            distinct = 0;
+            info.runs += sortStream<Triple>(
+                runPath, budgetBytes,
+                [&](Triple &x) {
+                    if (i == n)
+                        return false;
+                    first.next(x.a);
+                    x.b = 0; // fin del texto: menor que cualquier nombre
+                    if (i + h < n)
+                        second.next(x.b);
+                    x.pos = i++;
+                    return true;
+                },
+                [](const Triple &x, const Triple &y) { return x.a != y.a ? x.a < y.a : x.b < y.b; },
+                [&](const Triple &x) {
+                    if (k == 0 || x.a != prev.a || x.b != prev.b) {
+                        name = k + 1;
+                        distinct++;
+                    }
+                    pairs.push({x.pos, name});
+                    prev = x;
+                    k++;
+                });
+        }
+
+        {
+            RecordReader<Named> pairs(pairsPath, kBlock);
+            RecordWriter<uint64_t> out(saPath, kBlock);
+            for (Named x; pairs.next(x);)
+                out.push(x.pos);
+        }
+        std::remove(pairsPath.c_str());
+        std::remove(namesPath.c_str());
+        return info;
+    }
+
+    ExternalSuffixArray(const std::string &textPath, const std::string &saPath) : text(textPath), sa(saPath) {
+        sa.advise(MADV_RANDOM);
+        text.advise(MADV_RANDOM);
+    }
+
+    size_t size() const { return sa.size() / sizeof(uint64_t); }
+    uint64_t at(size_t i) const {
+        uint64_t v;
+        std::memcpy(&v, sa.data() + i * sizeof(uint64_t), sizeof v);
+        return v;
+    }
+
+    bool contains(std::string_view P) const {
+        auto [lo, hi] = range(P);
+        return lo < hi;
+    }
+
+    size_t countAll(std::string_view P) const {
+        auto [lo, hi] = range(P);
+        return hi - lo;
+    }
+
+    // Ocurrencias en orden del arreglo (lexicografico), no de posicion.
+    std::vector<uint64_t> findAll(std::string_view P) const {
+        auto [lo, hi] = range(P);
+        std::vector<uint64_t> res;
+        res.reserve(hi - lo);
+        for (size_t i = lo; i < hi; i++)
+            res.push_back(at(i));
+        return res;
+    }
+
+  private:
+    static constexpr size_t kBlock = 1 << 12; // registros por bloque de E/S
+    static constexpr size_t kFanIn = 64;      // corridas que se mezclan juntas
+
+    struct Named {
+        uint64_t pos, name;
+    };
+
+    struct Triple {
+        uint64_t a, b, pos;
+    };
+
+    MappedFile text, sa;
+
+    // compara los sufijos a y b en a lo sumo d caracteres; 0 si coinciden en
+    // los d (el mas corto es prefijo del otro si no llegan a d)
+    static int comparePrefix(const char *t, uint64_t n, uint64_t a, uint64_t b, uint64_t d) {
+        uint64_t la = n - a, lb = n - b;
+        int c = std::memcmp(t + a, t + b, std::min({la, lb, d}));
+        if (c != 0)
+            return c;
+        if (std::min(la, lb) >= d)
+            return 0;
+        return la < lb ? -1 : (la > lb);
+    }
+
+    // Ordena los registros que entrega next(x) (false al terminar) y llama
+    // emit(x) en orden. Si no entran en budgetBytes se ordenan por tramos que
+    // se escriben como corridas temporales y se mezclan. Devuelve las corridas.
+    template <class T, class Next, class Less, class Emit>
+    static size_t sortStream(const std::string &runPath, size_t budgetBytes, Next next, Less less, Emit emit) {
+        size_t cap = std::max<size_t>(1, budgetBytes / sizeof(T));
+        std::vector<T> chunk;
+        std::vector<std::string> runs;
+        T x;
+        for (bool more = true; more;) {
+            chunk.clear();
+            while (chunk.size() < cap && (more = next(x)))
+                chunk.push_back(x);
+            std::sort(chunk.begin(), chunk.end(), less);
+            if (runs.empty() && !more) {
+                for (const T &y : chunk)
+                    emit(y);
+                return 0;
+            }
+            if (!chunk.empty()) {
+                runs.push_back(runPath + std::to_string(runs.size()));
+                RecordWriter<T> w(runs.back(), kBlock);
+                for (const T &y : chunk)
+                    w.push(y);
+            }
+        }
+        chunk = std::vector<T>();
+        size_t total = runs.size(), block = std::max<size_t>(64, cap / std::min(runs.size(), kFanIn));
+
+        // por niveles, para no abrir mas de kFanIn corridas a la vez
+        while (runs.size() > kFanIn) {
+            std::vector<std::string> merged;
+            for (size_t r = 0; r < runs.size(); r += kFanIn) {
+                std::vector<std::string> group(runs.begin() + r, runs.begin() + std::min(r + kFanIn, runs.size()));
+                merged.push_back(runPath + std::to_string(total++));
+                RecordWriter<T> w(merged.back(), kBlock);
+                auto push = [&](const T &y) { w.push(y); };
+                merge<T>(group, block, less, push);
+            }
+            runs.swap(merged);
+        }
+        merge<T>(runs, block, less, emit);
+        return total;
+    }
+
+    // Mezcla k corridas ordenadas leyendo de a bloques; borra los temporales.
+    template <class T, class Less, class Emit>
+    static void merge(const std::vector<std::string> &runs, size_t block, Less less, Emit &emit) {
+        std::vector<RecordReader<T>> rs;
+        rs.reserve(runs.size());
+        using Item = std::pair<T, size_t>;
+        auto greater = [&](const Item &a, const Item &b) { return less(b.first, a.first); };
+        std::priority_queue<Item, std::vector<Item>, decltype(greater)> heap(greater);
+        for (size_t r = 0; r < runs.size(); r++) {
+            rs.emplace_back(runs[r], block);
+            T x;
+            if (rs[r].next(x))
+                heap.push({x, r});
+        }
+
+        while (!heap.empty()) {
+            auto [x, r] = heap.top();
+            heap.pop();
+            emit(x);
+            if (rs[r].next(x))
+                heap.push({x, r});
+        }
+
+        for (const std::string &path : runs)
+            std::remove(path.c_str());
+    }
+
+    // compara P con el sufijo en pos, solo hasta |P| caracteres
+    int comparePrefix(uint64_t pos, std::string_view P) const {
+        uint64_t n = text.size();
+        uint64_t m = std::min<uint64_t>(P.size(), n - pos);
+        int c = std::memcmp(text.data() + pos, P.data(), m);
+        if (c != 0)
+            return c;
+        return m < P.size() ? -1 : 0;
+    }
+
+    // rango [lo, hi) del arreglo cuyos sufijos empiezan con P
+    std::pair<size_t, size_t> range(std::string_view P) const {
+        size_t lo = 0, hi = size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (comparePrefix(at(mid), P) < 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        size_t first = lo;
+        hi = size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (comparePrefix(at(mid), P) <= 0)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return {first, lo};
+    }
+};
+
+} // namespace suffixtree
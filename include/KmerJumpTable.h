@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace suffixtree {
+
+// Tabla de salto para los primeros k simbolos de un patron: lleva directo al
+// locus (nodo + caracteres ya consumidos de su arista) sin pasar por los
+// unordered_map de los niveles cercanos a la raiz.
+//
+// Los simbolos se recodifican al alfabeto del texto, asi que k * bits por
+// simbolo debe caber en 64 bits (k <= 9 para texto comun, k <= 21 para ADN).
+template <class Node> class KmerJumpTable {
+  public:
+    struct Locus {
+        Node *node = nullptr;
+        int offset = 0; // caracteres de la arista hacia node ya consumidos
+    };
+
+    // Devuelve el k efectivo (se recorta si no cabe en 64 bits).
+    int build(const std::string &s, Node *root, int kWanted) {
+        code.assign(256, 0);
+        int sigma = 0;
+        for (unsigned char c : s)
+            if (!code[c])
+                code[c] = ++sigma;
+
+        bits = 1;
+        while ((1 << bits) <= sigma)
+            bits++;
+        k = std::max(1, std::min(kWanted, 64 / bits));
+
+        slots.clear();
+        entries = 0;
+        size_t cap = 1024;
+        shift = 54;
+        while (cap < 2 * countLoci(root, 0)) {
+            cap <<= 1;
+            shift--;
+        }
+        slots.assign(cap, Slot{});
+        mask = cap - 1;
+
+        fill(s, root, 0, 0);
+        return k;
+    }
+
+    int kmer() const { return k; }
+    size_t size() const { return entries; }
+    size_t bytes() const { return slots.size() * sizeof(Slot) + code.size() * sizeof(int); }
+
+    // Locus de los primeros k caracteres de P (P.size() >= k). node == nullptr
+    // si ese k-mer no aparece en el texto.
+    Locus find(std::string_view P) const {
+        uint64_t key = 0;
+        for (int i = 0; i < k; i++) {
+            int c = code[(unsigned char)P[i]];
+            if (!c)
+                return {};
+            key = (key << bits) | c;
+        }
+
+        for (size_t h = hash(key);; h = (h + 1) & mask) {
+            const Slot &sl = slots[h];
+            if (!sl.loc.node)
+                return {};
+            if (sl.key == key)
+                return sl.loc;
+        }
+    }
+
+  private:
+    struct Slot {
+        uint64_t key = 0;
+        Locus loc;
+    };
+
+    std::vector<Slot> slots;
+    std::vector<int> code;
+    size_t mask = 0;
+    int shift = 54;
+    size_t entries = 0;
+    int bits = 1;
+    int k = 0;
+
+    size_t hash(uint64_t key) const { return (size_t)((key * 0x9E3779B97F4A7C15ull) >> shift); }
+
+    size_t countLoci(Node *v, int depth) const {
+        size_t cnt = 0;
+        for (auto &kv : v->next) {
+            Node *w = kv.second;
+            if ((size_t)depth + w->len() >= (size_t)k)
+                cnt++;
+            else
+                cnt += countLoci(w, depth + (int)w->len());
+        }
+        return cnt;
+    }
+
+    void fill(const std::string &s, Node *v, int depth, uint64_t key) {
+        for (auto &kv : v->next) {
+            Node *w = kv.second;
+            int take = (int)std::min<size_t>(w->len(), k - depth);
+            uint64_t kk = key;
+            for (int j = 0; j < take; j++)
+                kk = (kk << bits) | code[(unsigned char)s[w->start + j]];
+
+            if (depth + take == k)
+                insert(kk, {w, take});
+            else
+                fill(s, w, depth + take, kk);
+        }
+    }
+
+    void insert(uint64_t key, Locus loc) {
+        size_t h = hash(key);
+        while (slots[h].loc.node)
+            h = (h + 1) & mask;
+        slots[h] = {key, loc};
+        entries++;
+    }
+};
+
+} // namespace suffixtree
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "SuffixArray.h"
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+// Pos es el tipo de las posiciones: uint32_t (40 bytes por nodo) alcanza hasta
+// 4 GB de texto; uint64_t (56 bytes) para corpus mas grandes.
+template <class Pos> struct LcpNodeT {
+    static constexpr uint64_t kMaxPos = std::numeric_limits<Pos>::max();
+
+    // hijos ordenados por primer caracter
+    std::vector<std::pair<unsigned char, LcpNodeT *>> next;
+    Pos start = Pos(-1), end = Pos(-1);
+    Pos suffixIndex = Pos(-1);
+    Pos depth = 0; // profundidad de cadena
+
+    LcpNodeT(Pos d, Pos suf = Pos(-1)) : suffixIndex(suf), depth(d) {}
+    Pos len() const { return end - start + 1; }
+};
+
+// Las mismas posiciones en campos de 40 bits (textos de hasta 1 TB). Van en
+// una base empaquetada de 20 bytes, asi el nodo ocupa 48 contra 56 con
+// uint64_t; las consultas ven posiciones uint64_t.
+struct __attribute__((packed)) LcpPositions40 {
+    static constexpr uint64_t kMaxPos = (uint64_t(1) << 40) - 1;
+
+    uint64_t start : 40 = kMaxPos, end : 40 = kMaxPos;
+    uint64_t suffixIndex : 40 = kMaxPos;
+    uint64_t depth : 40 = 0;
+};
+
+struct LcpNode40 : LcpPositions40 {
+    std::vector<std::pair<unsigned char, LcpNode40 *>> next;
+
+    LcpNode40(uint64_t d, uint64_t suf = kMaxPos) {
+        suffixIndex = suf;
+        depth = d;
+    }
+    uint64_t len() const { return end - start + 1; }
+};
+
+static_assert(sizeof(LcpNode40) == 48);
+
+// Arbol de sufijos a partir del arreglo de sufijos y el LCP: un solo barrido
+// de izquierda a derecha con una pila (el camino mas a la derecha), O(n).
+// Los hijos salen ya ordenados, asi que toSuffixArray no ordena en cada nodo.
+template <class Pos, class NodeT = LcpNodeT<Pos>>
+class BasicLcpSuffixTree : public SuffixTreeBase<BasicLcpSuffixTree<Pos, NodeT>, NodeT> {
+    using Base = SuffixTreeBase<BasicLcpSuffixTree<Pos, NodeT>, NodeT>;
+
+  public:
+    using Node = NodeT;
+    using Base::root;
+    using Base::s;
+
+    static constexpr bool kSortedChildren = true;
+
+    // el texto mas largo (con su '$') que se puede indexar con Pos
+    static constexpr uint64_t kMaxText = Node::kMaxPos - 1;
+
+    BasicLcpSuffixTree() = default;
+    explicit BasicLcpSuffixTree(std::string text) { build(std::move(text)); }
+
+    void build(std::string text) {
+        this->reset(std::move(text));
+        std::vector<Pos> SA = buildSuffixArray<Pos>(s);
+        std::vector<Pos> LCP = buildLcp(s, SA);
+        buildFromArrays(SA, LCP);
+    }
+
+    // SA y LCP ya calculados sobre text (con su '$' final).
+    void build(std::string text, const std::vector<Pos> &SA, const std::vector<Pos> &LCP) {
+        this->reset(std::move(text));
+        buildFromArrays(SA, LCP);
+    }
+
+    Node *child(const Node *v, unsigned char c) const {
+        auto it = std::lower_bound(v->next.begin(), v->next.end(), c,
+                                   [](const auto &kv, unsigned char x) { return kv.first < x; });
+        return (it != v->next.end() && it->first == c) ? it->second : nullptr;
+    }
+
+    Pos stringDepth(Node *v) const { return v->depth; }
+
+  private:
+    // Cuelga c de p. Hasta ese momento c->start guarda un sufijo cualquiera de
+    // su subarbol; con la profundidad del padre queda la etiqueta de la arista.
+    // Como los nodos se cierran en orden del SA, los hijos llegan ordenados.
+    void attach(Node *p, Node *c) {
+        Pos r = c->start;
+        c->start = r + p->depth;
+        c->end = r + c->depth - 1;
+        p->next.emplace_back((unsigned char)s[c->start], c);
+    }
+
+    // SA puede traer solo algunos sufijos (arbol disperso); LCP[i] es el
+    // prefijo comun entre SA[i-1] y SA[i].
+    void buildFromArrays(const std::vector<Pos> &SA, const std::vector<Pos> &LCP) {
+        Pos n = (Pos)s.size();
+        root = this->makeNode(0);
+
+        // camino mas a la derecha del arbol construido hasta SA[i-1]
+        std::vector<Node *> stack = {root};
+        for (size_t i = 0; i < SA.size(); i++) {
+            Pos suf = SA[i];
+            Pos l = i == 0 ? 0 : LCP[i];
+
+            while (stack.back()->depth > l) {
+                Node *last = stack.back();
+                stack.pop_back();
+
+                if (stack.back()->depth >= l) {
+                    attach(stack.back(), last);
+                } else {
+                    // el LCP cae a mitad de arista: nodo interno nuevo
+                    Node *mid = this->makeNode(l);
+                    mid->start = last->start;
+                    attach(mid, last);
+                    stack.push_back(mid);
+                    ST_COUNT(splits, 1);
+                }
+            }
+
+            Node *leaf = this->makeNode(n - suf, suf);
+            leaf->start = suf;
+            stack.push_back(leaf);
+            ST_COUNT(leaves, 1);
+        }
+
+        while (stack.size() > 1) {
+            Node *last = stack.back();
+            stack.pop_back();
+            attach(stack.back(), last);
+        }
+        root->start = Node::kMaxPos;
+    }
+};
+
+using LcpNode = LcpNodeT<uint32_t>;
+using LcpSuffixTree = BasicLcpSuffixTree<uint32_t>;
+using LcpSuffixTree40 = BasicLcpSuffixTree<uint64_t, LcpNode40>;
+using LcpSuffixTree64 = BasicLcpSuffixTree<uint64_t>;
+
+static_assert(SuffixIndex<LcpSuffixTree> && NodeTraversable<LcpSuffixTree>);
+static_assert(SuffixIndex<LcpSuffixTree40> && NodeTraversable<LcpSuffixTree40>);
+static_assert(SuffixIndex<LcpSuffixTree64> && NodeTraversable<LcpSuffixTree64>);
+
+// Construye el arbol con el ancho de posicion mas chico que alcanza para text
+// (32, 40 o 64 bits) y se lo pasa a f, que debe aceptar todos (p. ej. una
+// lambda generica) y devolver lo mismo en cada caso.
+template <class F> auto withLcpSuffixTree(std::string text, F &&f) {
+    if (text.size() + 1 <= LcpSuffixTree::kMaxText) {
+        LcpSuffixTree t(std::move(text));
+        return f(t);
+    }
+    if (text.size() + 1 <= LcpSuffixTree40::kMaxText) {
+        LcpSuffixTree40 t(std::move(text));
+        return f(t);
+    }
+    LcpSuffixTree64 t(std::move(text));
+    return f(t);
+}
+
+} // namespace suffixtree
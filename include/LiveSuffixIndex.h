@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "UkkonenSuffixTree.h"
+
+namespace suffixtree {
+
+// Indice en vivo: un unico hilo escritor agrega texto con append (Ukkonen en
+// linea) y publica una instantanea inmutable (snapshot cerrado con '$') cada
+// max(publishEvery, growth * n) caracteres, con n el largo ya indexado. Los lectores consultan la ultima instantanea
+// publicada sin bloquearse nunca: la liberacion de las viejas es por epocas,
+// el escritor solo borra una cuando ningun lector puede seguir usandola.
+//
+// Publicar copia el arbol, O(n). Con un intervalo fijo la ingesta costaria
+// O(n^2 / publishEvery); como el intervalo crece con n, las copias suman
+// O(n (1 + 1/growth)) y la ingesta queda lineal. A cambio, lo agregado tarda
+// en verse a lo sumo publishEvery caracteres o una fraccion growth del texto.
+// publish() fuerza una publicacion en cualquier momento.
+class LiveSuffixIndex {
+  public:
+    using Tree = UkkonenSuffixTree;
+    static constexpr int kMaxReaders = 64;
+
+    // Acceso de un hilo lector. Cada hilo usa el suyo.
+    class Reader {
+      public:
+        Reader(Reader &&o) noexcept : idx(std::exchange(o.idx, nullptr)), slot(o.slot) {}
+        Reader(const Reader &) = delete;
+        ~Reader() {
+            if (idx)
+                idx->slots[slot].used.store(false, std::memory_order_release);
+        }
+
+        // f(const Tree &) sobre la ultima instantanea; devuelve lo que f devuelva.
+        template <class F> decltype(auto) read(F &&f) {
+            Slot &sl = idx->slots[slot];
+            sl.epoch.store(idx->epoch.load());
+            const Tree *t = idx->current.load();
+
+            struct Unpin {
+                Slot &sl;
+                ~Unpin() { sl.epoch.store(0, std::memory_order_release); }
+            } unpin{sl};
+            return f(*t);
+        }
+
+      private:
+        friend class LiveSuffixIndex;
+        Reader(LiveSuffixIndex *i, int s) : idx(i), slot(s) {}
+
+        LiveSuffixIndex *idx;
+        int slot;
+    };
+
+    explicit LiveSuffixIndex(size_t publishEvery = 1 << 16, double growth = 0.125)
+        : every(publishEvery), growth(growth > 0 ? growth : 0.125) {
+        current.store(new Tree(live.snapshot()));
+    }
+
+    LiveSuffixIndex(const LiveSuffixIndex &) = delete;
+    LiveSuffixIndex &operator=(const LiveSuffixIndex &) = delete;
+
+    // Los lectores deben haber terminado.
+    ~LiveSuffixIndex() {
+        delete current.load();
+        for (auto &r : retired)
+            delete r.first;
+    }
+
+    // Falla (aborta) si ya hay kMaxReaders lectores.
+    Reader reader() {
+        for (int i = 0; i < kMaxReaders; i++) {
+            bool expected = false;
+            if (slots[i].used.compare_exchange_strong(expected, true))
+                return Reader(this, i);
+        }
+        std::cerr << "Error: demasiados lectores\n";
+        std::abort();
+    }
+
+    // Solo desde el hilo escritor.
+    void append(std::string_view chunk) {
+        live.append(chunk);
+        pending += chunk.size();
+        if (pending >= std::max(every, (size_t)(growth * (double)live.s.size())))
+            publish();
+    }
+
+    // Publica ya lo agregado hasta ahora (solo desde el hilo escritor).
+    void publish() {
+        Tree *fresh = new Tree(live.snapshot());
+        const Tree *old = current.exchange(fresh);
+        retired.emplace_back(old, epoch.fetch_add(1));
+        pending = 0;
+        published++;
+        reclaim();
+    }
+
+    size_t version() const { return published; }
+    size_t size() const { return live.s.size(); } // solo desde el escritor
+    size_t retiredCount() const { return retired.size(); }
+
+  private:
+    // epoch == 0: el lector no esta dentro de read
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<bool> used{false};
+    };
+
+    Tree live;
+    std::atomic<const Tree *> current{nullptr};
+    std::atomic<uint64_t> epoch{1};
+    Slot slots[kMaxReaders];
+    std::vector<std::pair<const Tree *, uint64_t>> retired; // (arbol, epoca de retiro)
+    size_t every;
+    double growth;
+    size_t pending = 0;
+    size_t published = 0;
+
+    // Una instantanea retirada en la epoca e puede estar en uso solo por un
+    // lector que anuncio una epoca <= e.
+    void reclaim() {
+        uint64_t oldest = UINT64_MAX;
+        for (Slot &sl : slots) {
+            uint64_t e = sl.epoch.load();
+            if (e != 0 && e < oldest)
+                oldest = e;
+        }
+
+        size_t kept = 0;
+        for (auto &r : retired) {
+            if (r.second < oldest)
+                delete r.first;
+            else
+                retired[kept++] = r;
+        }
+        retired.resize(kept);
+    }
+};
+
+} // namespace suffixtree
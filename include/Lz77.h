@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+// Factor de la factorizacion LZ77 (longest previous factor): el texto desde
+// pos repite len caracteres que ya empezaban en src < pos (pueden solaparse).
+// len == 0 es un literal: el caracter text[pos], que no aparecia antes.
+struct Lz77Factor {
+    uint64_t pos = 0;
+    uint64_t len = 0;
+    uint64_t src = 0;
+};
+
+// Resumen de la factorizacion y tamano estimado con un codigo simple: un bit
+// de tipo, el literal en 8 bits o bien gamma de Elias del largo mas la
+// distancia en ceil(log2 pos) bits.
+struct Lz77Stats {
+    uint64_t chars = 0, factors = 0, literals = 0, longest = 0;
+    uint64_t bits = 0;
+
+    void add(const Lz77Factor &f) {
+        factors++;
+        if (f.len == 0) {
+            literals++;
+            chars++;
+            bits += 1 + 8;
+            return;
+        }
+        chars += f.len;
+        longest = std::max(longest, f.len);
+        bits += 1 + 2 * (std::bit_width(f.len) - 1) + 1 + std::bit_width(f.pos - 1);
+    }
+
+    double bitsPerChar() const { return chars ? (double)bits / chars : 0; }
+};
+
+// Factorizacion en O(n) a partir del arreglo de sufijos de text: para cada
+// posicion, la fuente mas larga es el sufijo anterior mas cercano en el SA
+// con posicion menor (PSV) o el siguiente (NSV), y la suma de los largos
+// comparados es n. out(const Lz77Factor &) recibe cada factor en orden.
+template <class Pos, class Out> Lz77Stats lz77Factorize(std::string_view text, const std::vector<Pos> &SA, Out &&out) {
+    const Pos none = Pos(-1);
+    size_t n = SA.size();
+    std::vector<Pos> psv(n, none), nsv(n, none);
+    std::vector<Pos> stack;
+    for (Pos x : SA) {
+        while (!stack.empty() && stack.back() > x) {
+            nsv[stack.back()] = x;
+            stack.pop_back();
+        }
+        if (!stack.empty())
+            psv[x] = stack.back();
+        stack.push_back(x);
+    }
+    stack = {};
+
+    auto match = [&](uint64_t i, Pos c) -> uint64_t {
+        if (c == none)
+            return 0;
+        uint64_t l = 0;
+        while (i + l < n && text[c + l] == text[i + l])
+            l++;
+        return l;
+    };
+
+    Lz77Stats st;
+    for (uint64_t i = 0; i < n;) {
+        uint64_t lp = match(i, psv[i]), ln = match(i, nsv[i]);
+        Lz77Factor f;
+        f.pos = i;
+        if (lp == 0 && ln == 0) {
+            f.src = (unsigned char)text[i];
+            i++;
+        } else {
+            f.len = std::max(lp, ln);
+            f.src = lp >= ln ? psv[i] : nsv[i];
+            i += f.len;
+        }
+        st.add(f);
+        out(f);
+    }
+    return st;
+}
+
+// La misma factorizacion sobre el texto de un arbol ya construido (con su
+// '$'), usando su toSuffixArray. Solo para arboles de todos los sufijos.
+template <SuffixIndex Tree, class Out> Lz77Stats lz77Factorize(const Tree &t, Out &&out) {
+    return lz77Factorize(t.s, t.toSuffixArray(), out);
+}
+
+// Formato de flujo: por factor, el largo en varint y despues el caracter
+// (literal) o la distancia pos - src en varint.
+class Lz77Writer {
+  public:
+    explicit Lz77Writer(std::ostream &os) : os(os) {}
+
+    void operator()(const Lz77Factor &f) {
+        varint(f.len);
+        if (f.len == 0) {
+            os.put((char)f.src);
+            written++;
+        } else {
+            varint(f.pos - f.src);
+        }
+    }
+
+    uint64_t bytes() const { return written; }
+
+  private:
+    std::ostream &os;
+    uint64_t written = 0;
+
+    void varint(uint64_t x) {
+        do {
+            unsigned char b = x & 0x7f;
+            x >>= 7;
+            os.put((char)(x ? b | 0x80 : b));
+            written++;
+        } while (x);
+    }
+};
+
+// Reconstruye el texto escrito por Lz77Writer.
+inline std::string lz77Decode(std::istream &in) {
+    auto varint = [&](uint64_t &x) {
+        x = 0;
+        for (int shift = 0;; shift += 7) {
+            int b = in.get();
+            if (b == EOF)
+                return false;
+            x |= (uint64_t)(b & 0x7f) << shift;
+            if (!(b & 0x80))
+                return true;
+        }
+    };
+
+    std::string text;
+    uint64_t len, dist;
+    while (varint(len)) {
+        if (len == 0) {
+            int c = in.get();
+            if (c == EOF)
+                break;
+            text.push_back((char)c);
+            continue;
+        }
+        if (!varint(dist))
+            break;
+        size_t from = text.size() - dist;
+        for (uint64_t k = 0; k < len; k++)
+            text.push_back(text[from + k]);
+    }
+    return text;
+}
+
+} // namespace suffixtree
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+// Pos es un entero con signo (-1 marca "sin valor"): int32_t hasta 2 GB de
+// texto, int64_t para corpus mas grandes.
+template <class Pos> struct McCreightNodeT {
+    std::unordered_map<unsigned char, McCreightNodeT *> next;
+    McCreightNodeT *link = nullptr;
+    McCreightNodeT *parent = nullptr;
+    Pos start, end;
+    Pos suffixIndex = -1;
+
+    McCreightNodeT(Pos s = -1, Pos e = -1, McCreightNodeT *p = nullptr, Pos suf = -1)
+        : parent(p), start(s), end(e), suffixIndex(suf) {}
+    Pos len() const { return end - start + 1; }
+};
+
+// McCreight (1976): inserta los sufijos de mayor a menor longitud usando
+// suffix links y rescan, O(n).
+template <class Pos>
+class BasicMcCreightSuffixTree : public SuffixTreeBase<BasicMcCreightSuffixTree<Pos>, McCreightNodeT<Pos>> {
+    using Base = SuffixTreeBase<BasicMcCreightSuffixTree<Pos>, McCreightNodeT<Pos>>;
+
+  public:
+    using Node = McCreightNodeT<Pos>;
+    using Base::root;
+    using Base::s;
+
+    // el texto mas largo (con su '$') que se puede indexar con Pos
+    static constexpr uint64_t kMaxText = (uint64_t)std::numeric_limits<Pos>::max() - 1;
+
+    BasicMcCreightSuffixTree() = default;
+    explicit BasicMcCreightSuffixTree(std::string text) { build(std::move(text)); }
+
+    void build(std::string text) {
+        this->reset(std::move(text));
+        root = this->makeNode(-1, -1);
+
+        Node *head = root; // h en el paper: locus de head(i-1)
+        Pos headDepth = 0;
+
+        for (Pos i = 0; i < (Pos)s.size(); i++) {
+            std::tie(head, headDepth) = insertSuffix(i, head, headDepth);
+        }
+    }
+
+    // Con punteros al padre no hace falta buscar el camino desde la raiz.
+    std::string pathLabel(Node *v) const {
+        std::string label = "";
+
+        while (v != root) {
+            label = s.substr(v->start, v->len()) + label;
+            v = v->parent;
+        }
+
+        return label;
+    }
+
+    Pos stringDepth(Node *v) const {
+        Pos depth = 0;
+
+        while (v != root) {
+            depth += v->len();
+            v = v->parent;
+        }
+
+        return depth;
+    }
+
+  private:
+    // Parte la arista hacia w dejando r caracteres sobre el nodo nuevo.
+    Node *splitEdge(Node *v, Node *w, Pos r) {
+        unsigned char c = s[w->start];
+        Node *mid = this->makeNode(w->start, w->start + r - 1, v);
+        v->next[c] = mid;
+
+        w->start += r;
+        w->parent = mid;
+        mid->next[s[w->start]] = w;
+
+        ST_COUNT(splits, 1);
+        ST_COUNT(mapProbes, 2);
+        return mid;
+    }
+
+    void addLeaf(Node *v, Pos j, Pos i) {
+        v->next[s[j]] = this->makeNode(j, (Pos)s.size() - 1, v, i);
+        ST_COUNT(leaves, 1);
+        ST_COUNT(mapProbes, 1);
+    }
+
+    // Inserta el sufijo i sabiendo que head(i-1) = x alpha tiene locus head y
+    // profundidad headDepth. Retorna el locus y la profundidad de head(i).
+    std::pair<Node *, Pos> insertSuffix(Pos i, Node *head, Pos headDepth) {
+        Node *v = root;
+        Pos depth = 0;
+
+        if (head != root && head->link) {
+            // head ya existia: su suffix link lleva directo a alpha
+            v = head->link;
+            depth = headDepth - 1;
+            ST_COUNT(linkHops, 1);
+        } else if (head != root) {
+            // rescan: alpha = beta' + beta, donde beta es la arista hacia head.
+            // Se sabe que beta esta en el arbol, asi que se saltan aristas
+            // completas comparando solo su primer caracter.
+            Node *u = head->parent;
+            Pos b = head->start;
+            Pos r = head->len();
+
+            if (u == root) {
+                b++;
+                r--;
+            } else {
+                v = u->link;
+                ST_COUNT(linkHops, 1);
+            }
+            depth = headDepth - 1 - r;
+
+            while (r > 0) {
+                Node *w = v->next[s[b]];
+                ST_COUNT(mapProbes, 1);
+                Pos L = w->len();
+
+                // alpha termina a mitad de arista: el nodo nuevo es head(i)
+                if (L > r) {
+                    Node *mid = splitEdge(v, w, r);
+                    head->link = mid;
+                    addLeaf(mid, i + depth + r, i);
+                    return {mid, depth + r};
+                }
+
+                ST_COUNT(walkDownSkips, 1);
+                v = w;
+                b += L;
+                r -= L;
+                depth += L;
+            }
+            head->link = v;
+        }
+
+        // scan: desde alpha se compara caracter a caracter
+        Pos j = i + depth;
+        while (true) {
+            unsigned char c = s[j];
+
+            // si no hay arista, crear hoja y salir
+            auto it = v->next.find(c);
+            ST_COUNT(mapProbes, 1);
+            if (it == v->next.end()) {
+                addLeaf(v, j, i);
+                return {v, depth};
+            }
+
+            Node *w = it->second;
+            Pos k = w->start;
+
+            // caminar por la arista
+            while (k <= w->end && j < (Pos)s.size() && s[k] == s[j]) {
+                k++;
+                j++;
+            }
+            ST_COUNT(charsCompared, k - w->start + (k <= w->end ? 1 : 0));
+
+            // si la arista coincide totalmente continuar bajando
+            if (k > w->end) {
+                v = w;
+                depth += w->len();
+                continue;
+            }
+
+            // mismatch -> split
+            Node *mid = splitEdge(v, w, k - w->start);
+            addLeaf(mid, j, i);
+            return {mid, depth + mid->len()};
+        }
+    }
+};
+
+using McCreightNode = McCreightNodeT<int32_t>;
+using McCreightSuffixTree = BasicMcCreightSuffixTree<int32_t>;
+using McCreightSuffixTree64 = BasicMcCreightSuffixTree<int64_t>;
+
+static_assert(SuffixIndex<McCreightSuffixTree> && NodeTraversable<McCreightSuffixTree>);
+static_assert(SuffixIndex<McCreightSuffixTree64> && NodeTraversable<McCreightSuffixTree64>);
+
+// Construye el arbol con el ancho de posicion mas chico que alcanza para text
+// y se lo pasa a f (como withLcpSuffixTree).
+template <class F> auto withMcCreightSuffixTree(std::string text, F &&f) {
+    if (text.size() + 1 <= McCreightSuffixTree::kMaxText) {
+        McCreightSuffixTree t(std::move(text));
+        return f(t);
+    }
+    McCreightSuffixTree64 t(std::move(text));
+    return f(t);
+}
+
+} // namespace suffixtree
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+// Pos es un entero con signo (-1 marca "sin valor"): int32_t hasta 2 GB de
+// texto, int64_t para corpus mas grandes.
+template <class Pos> struct NaiveNodeT {
+    std::map<unsigned char, NaiveNodeT *> next;
+    Pos start = -1, end = -1;
+    Pos suffixIndex = -1;
+
+    NaiveNodeT(Pos s = -1, Pos e = -1, Pos suf = -1) : start(s), end(e), suffixIndex(suf) {}
+    Pos len() const { return end - start + 1; }
+};
+
+// Inserta cada sufijo desde la raiz: O(n^2) en el peor caso.
+template <class Pos> class BasicNaiveSuffixTree : public SuffixTreeBase<BasicNaiveSuffixTree<Pos>, NaiveNodeT<Pos>> {
+    using Base = SuffixTreeBase<BasicNaiveSuffixTree<Pos>, NaiveNodeT<Pos>>;
+
+  public:
+    using Node = NaiveNodeT<Pos>;
+    using Base::root;
+    using Base::s;
+
+    static constexpr bool kSortedChildren = true;
+
+    // el texto mas largo (con su '$') que se puede indexar con Pos
+    static constexpr uint64_t kMaxText = (uint64_t)std::numeric_limits<Pos>::max() - 1;
+
+    BasicNaiveSuffixTree() = default;
+    explicit BasicNaiveSuffixTree(std::string text) { build(std::move(text)); }
+
+    void build(std::string text) {
+        this->reset(std::move(text));
+        root = this->makeNode();
+
+        for (Pos i = 0; i < (Pos)s.size(); i++)
+            insertSuffix(i);
+    }
+
+  private:
+    void insertSuffix(Pos pos) {
+        Node *cur = root;
+        Pos i = pos;
+        Pos n = (Pos)s.size();
+
+        while (i < n) {
+            unsigned char c = s[i];
+            auto it = cur->next.find(c);
+            ST_COUNT(mapProbes, 1);
+
+            if (it == cur->next.end()) {
+                cur->next[c] = this->makeNode(i, n - 1, pos);
+                ST_COUNT(leaves, 1);
+                return;
+            }
+
+            Node *e = it->second;
+            Pos l = e->start, r = e->end;
+            Pos k = 0;
+            while ((l + k) <= r && (i + k) < n && s[l + k] == s[i + k])
+                k++;
+            ST_COUNT(charsCompared, k + 1);
+
+            if ((l + k) > r) {
+                cur = e;
+                i += k;
+                continue;
+            }
+
+            Node *mid = this->makeNode(l, l + k - 1);
+            it->second = mid;
+            e->start = l + k;
+            mid->next[s[l + k]] = e;
+            mid->next[s[i + k]] = this->makeNode(i + k, n - 1, pos);
+            ST_COUNT(splits, 1);
+            ST_COUNT(leaves, 1);
+
+            return;
+        }
+    }
+};
+
+using NaiveNode = NaiveNodeT<int32_t>;
+using NaiveSuffixTree = BasicNaiveSuffixTree<int32_t>;
+using NaiveSuffixTree64 = BasicNaiveSuffixTree<int64_t>;
+
+static_assert(SuffixIndex<NaiveSuffixTree> && NodeTraversable<NaiveSuffixTree>);
+static_assert(SuffixIndex<NaiveSuffixTree64> && NodeTraversable<NaiveSuffixTree64>);
+
+// Construye el arbol con el ancho de posicion mas chico que alcanza para text
+// y se lo pasa a f (como withLcpSuffixTree).
+template <class F> auto withNaiveSuffixTree(std::string text, F &&f) {
+    if (text.size() + 1 <= NaiveSuffixTree::kMaxText) {
+        NaiveSuffixTree t(std::move(text));
+        return f(t);
+    }
+    NaiveSuffixTree64 t(std::move(text));
+    return f(t);
+}
+
+} // namespace suffixtree
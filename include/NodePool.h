@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace suffixtree {
+
+// Nodos de un arbol guardados en bloques contiguos. Con un new por nodo
+// malloc redondea cada pedido a su tamano de chunk y le suma su encabezado,
+// asi que achicar el nodo (por ejemplo posiciones de 40 bits) no se notaba.
+// Los bloques crecen al doble hasta kMaxBlock nodos, de modo que lo reservado
+// y sin usar queda acotado. Las direcciones de los nodos no cambian mientras
+// el pool vive, ni al moverlo.
+template <class Node> class NodePool {
+    struct Block {
+        Node *nodes;
+        size_t used, cap;
+    };
+
+  public:
+    static constexpr size_t kMinBlock = 16;
+    static constexpr size_t kMaxBlock = size_t(1) << 16;
+
+    NodePool() = default;
+    NodePool(NodePool &&o) noexcept : blocks(std::exchange(o.blocks, {})), count(std::exchange(o.count, 0)) {}
+    NodePool &operator=(NodePool &&o) noexcept {
+        if (this != &o) {
+            clear();
+            blocks = std::exchange(o.blocks, {});
+            count = std::exchange(o.count, 0);
+        }
+        return *this;
+    }
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+    ~NodePool() { clear(); }
+
+    template <class... Args> Node *make(Args &&...args) {
+        if (blocks.empty() || blocks.back().used == blocks.back().cap)
+            grow(blocks.empty() ? kMinBlock : std::min(2 * blocks.back().cap, kMaxBlock));
+        Block &b = blocks.back();
+        Node *v = ::new (static_cast<void *>(b.nodes + b.used)) Node(std::forward<Args>(args)...);
+        b.used++;
+        count++;
+        return v;
+    }
+
+    // deja lugar para n nodos en total en un solo bloque (p. ej. al copiar un arbol)
+    void reserve(size_t n) {
+        size_t room = blocks.empty() ? 0 : blocks.back().cap - blocks.back().used;
+        if (n > count + room)
+            grow(n - count);
+    }
+
+    void clear() {
+        for (Block &b : blocks) {
+            std::destroy_n(b.nodes, b.used);
+            std::allocator<Node>().deallocate(b.nodes, b.cap);
+        }
+        blocks.clear();
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+
+    // recorre los nodos en orden de creacion
+    class iterator {
+      public:
+        iterator(const Block *b, const Block *e) : b(b), e(e) { skip(); }
+        Node *operator*() const { return b->nodes + i; }
+        iterator &operator++() {
+            i++;
+            skip();
+            return *this;
+        }
+        bool operator!=(const iterator &o) const { return b != o.b || i != o.i; }
+
+      private:
+        const Block *b, *e;
+        size_t i = 0;
+
+        void skip() {
+            while (b != e && i == b->used) {
+                b++;
+                i = 0;
+            }
+        }
+    };
+
+    iterator begin() const { return {blocks.data(), blocks.data() + blocks.size()}; }
+    iterator end() const { return {blocks.data() + blocks.size(), blocks.data() + blocks.size()}; }
+
+  private:
+    std::vector<Block> blocks;
+    size_t count = 0;
+
+    void grow(size_t cap) {
+        blocks.reserve(blocks.size() + 1);
+        blocks.push_back({std::allocator<Node>().allocate(cap), 0, cap});
+    }
+};
+
+} // namespace suffixtree
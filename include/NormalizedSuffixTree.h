@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+struct Normalization {
+    bool foldCase = true;          // 'A'-'Z' como 'a'-'z'
+    bool stripPunctuation = false; // descarta los signos de puntuacion
+    bool collapseSpaces = true;    // cada racha de blancos queda en un ' '
+};
+
+// Aplica norm a text y llama emit(c, i) por cada caracter que queda, con i su
+// posicion en text. Es la misma funcion para el texto y para los patrones.
+template <class F> void normalizeText(std::string_view text, const Normalization &norm, F &&emit) {
+    bool lastSpace = false;
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = text[i];
+        if (norm.stripPunctuation && std::ispunct(c))
+            continue;
+        if (norm.collapseSpaces && std::isspace(c)) {
+            if (lastSpace)
+                continue;
+            c = ' ';
+        }
+        if (norm.foldCase && c >= 'A' && c <= 'Z')
+            c = c - 'A' + 'a';
+        lastSpace = c == ' ';
+        emit((char)c, i);
+    }
+}
+
+// Un solo arbol sobre la vista normalizada del texto (por ejemplo en
+// minusculas y con los blancos colapsados) en lugar de un segundo arbol
+// completo sobre esa vista al lado del arbol del original. El texto si se
+// guarda dos veces: el original (para findAllExact y text()) y la vista
+// normalizada dentro del arbol, o sea hasta 2 bytes por caracter ademas de
+// los nodos y el mapa. Los patrones se normalizan igual y las ocurrencias se
+// devuelven como posiciones del texto original, traducidas con un mapa que
+// solo guarda los puntos donde cambia el desplazamiento entre las dos vistas.
+// Un patron no vacio que normalizado queda vacio (por ejemplo solo
+// puntuacion con stripPunctuation) no aparece en ningun lado.
+template <SuffixIndex Tree = LcpSuffixTree> class NormalizedSuffixTree {
+  public:
+    explicit NormalizedSuffixTree(Normalization norm = {}) : norm(norm) {}
+    NormalizedSuffixTree(std::string text, Normalization norm = {}) : norm(norm) { build(std::move(text)); }
+
+    void build(std::string text) {
+        if (!text.empty() && text.back() == '$')
+            text.pop_back();
+        original = std::move(text);
+        mapAt.clear();
+        mapShift.clear();
+
+        std::string view;
+        view.reserve(original.size() + 1);
+        uint64_t shift = 0;
+        normalizeText(original, norm, [&](char c, size_t i) {
+            if (i - view.size() != shift || mapAt.empty()) {
+                shift = i - view.size();
+                mapAt.push_back(view.size());
+                mapShift.push_back(shift);
+            }
+            view.push_back(c);
+        });
+        normalizedSize = view.size();
+        t.build(std::move(view));
+    }
+
+    std::string normalize(std::string_view P) const {
+        std::string out;
+        out.reserve(P.size());
+        normalizeText(P, norm, [&](char c, size_t) { out.push_back(c); });
+        return out;
+    }
+
+    // posicion en el texto original del caracter i de la vista normalizada
+    uint64_t toOriginal(uint64_t i) const {
+        if (i >= normalizedSize)
+            return original.size();
+        size_t k = std::upper_bound(mapAt.begin(), mapAt.end(), i) - mapAt.begin() - 1;
+        return i + mapShift[k];
+    }
+
+    bool contains(std::string_view P) const {
+        std::string Q = normalize(P);
+        return !vanished(P, Q) && t.contains(Q);
+    }
+
+    int countAll(std::string_view P) const {
+        std::string Q = normalize(P);
+        return vanished(P, Q) ? 0 : t.countAll(Q);
+    }
+
+    // Posiciones en el texto original, en el orden del recorrido.
+    std::vector<uint64_t> findAll(std::string_view P) const {
+        std::vector<uint64_t> res;
+        std::string Q = normalize(P);
+        if (vanished(P, Q))
+            return res;
+        t.forEachMatch(Q, [&](auto pos) {
+            res.push_back(toOriginal(pos));
+            return true;
+        });
+        return res;
+    }
+
+    // Solo las que coinciden tal cual en el original (busqueda exacta con el
+    // mismo arbol). No encuentra las que empiezan en un caracter descartado.
+    std::vector<uint64_t> findAllExact(std::string_view P) const {
+        std::vector<uint64_t> res;
+        std::string Q = normalize(P);
+        if (vanished(P, Q))
+            return res;
+        t.forEachMatch(Q, [&](auto pos) {
+            uint64_t o = toOriginal(pos);
+            if (original.compare(o, P.size(), P) == 0)
+                res.push_back(o);
+            return true;
+        });
+        return res;
+    }
+
+    std::vector<uint64_t> toSuffixArray() const {
+        auto sa = t.toSuffixArray();
+        std::vector<uint64_t> res(sa.size());
+        for (size_t i = 0; i < sa.size(); i++)
+            res[i] = toOriginal(sa[i]);
+        return res;
+    }
+
+    NodeCounts nodeCounts() const { return t.nodeCounts(); }
+
+    const std::string &text() const { return original; }
+    const Tree &tree() const { return t; }
+    size_t mapBytes() const { return (mapAt.capacity() + mapShift.capacity()) * sizeof(uint64_t); }
+
+  private:
+    Normalization norm;
+    std::string original;
+    uint64_t normalizedSize = 0;
+    // desde mapAt[k] (vista normalizada) se suma mapShift[k] para ir al original
+    std::vector<uint64_t> mapAt, mapShift;
+    Tree t;
+
+    // el patron tenia algo y la normalizacion lo borro entero
+    static bool vanished(std::string_view P, const std::string &Q) { return Q.empty() && !P.empty(); }
+};
+
+static_assert(SuffixIndex<NormalizedSuffixTree<>>);
+
+} // namespace suffixtree
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace suffixtree {
+
+// Filtro de Bloom sobre los q-gramas del texto. Si algun q-grama del patron
+// no esta, el patron no aparece y se rechaza sin recorrer el arbol. Puede dar
+// falsos positivos (se cae al recorrido normal) pero nunca falsos negativos.
+class QGramFilter {
+  public:
+    // budgetBytes acota el bitset; hashes es la cantidad de funciones del Bloom.
+    // Con menos de 8 bytes no entra ni una palabra: el filtro queda vacio (no
+    // ocupa nada y deja pasar todos los patrones).
+    void build(const std::string &s, int qWanted, size_t budgetBytes, int hashes = 2) {
+        q = qWanted < 1 ? 1 : qWanted;
+        k = hashes < 1 ? 1 : hashes;
+
+        size_t words = budgetBytes / sizeof(uint64_t);
+        if (words == 0) {
+            bits.clear();
+            bits.shrink_to_fit();
+            return;
+        }
+        nbits = 64;
+        while (nbits * 2 <= words * 64)
+            nbits *= 2;
+        bits.assign(nbits / 64, 0);
+
+        powQ = 1;
+        for (int i = 1; i < q; i++)
+            powQ *= kBase;
+
+        uint64_t h = 0;
+        for (int i = 0; i < (int)s.size(); i++) {
+            h = roll(h, i >= q ? s[i - q] : 0, s[i], i >= q);
+            if (i + 1 >= q)
+                set(h);
+        }
+    }
+
+    int qgram() const { return q; }
+    size_t bytes() const { return bits.size() * sizeof(uint64_t); }
+
+    // false solo si P seguro no aparece en el texto
+    bool mayContain(std::string_view P) const {
+        if (bits.empty() || (int)P.size() < q)
+            return true;
+
+        uint64_t h = 0;
+        for (int i = 0; i < (int)P.size(); i++) {
+            h = roll(h, i >= q ? P[i - q] : 0, P[i], i >= q);
+            if (i + 1 >= q && !test(h))
+                return false;
+        }
+        return true;
+    }
+
+  private:
+    static constexpr uint64_t kBase = 0x100000001B3ull;
+
+    std::vector<uint64_t> bits;
+    uint64_t nbits = 64;
+    uint64_t powQ = 1;
+    int q = 1;
+    int k = 2;
+
+    // hash polinomial rodante (mod 2^64) del ultimo q-grama
+    uint64_t roll(uint64_t h, char out, char in, bool drop) const {
+        if (drop)
+            h -= ((uint64_t)(unsigned char)out + 1) * powQ;
+        return h * kBase + (unsigned char)in + 1;
+    }
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // doble hashing: h1 + i*h2
+    void set(uint64_t h) {
+        uint64_t a = mix(h), b = mix(a) | 1;
+        for (int i = 0; i < k; i++) {
+            uint64_t p = (a + i * b) & (nbits - 1);
+            bits[p >> 6] |= 1ull << (p & 63);
+        }
+    }
+
+    bool test(uint64_t h) const {
+        uint64_t a = mix(h), b = mix(a) | 1;
+        for (int i = 0; i < k; i++) {
+            uint64_t p = (a + i * b) & (nbits - 1);
+            if (!(bits[p >> 6] >> (p & 63) & 1))
+                return false;
+        }
+        return true;
+    }
+};
+
+} // namespace suffixtree
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+struct CacheStats {
+    long long countHits = 0, countMisses = 0;
+    long long listHits = 0, listMisses = 0;
+    long long countEvictions = 0, listEvictions = 0;
+    long long rejected = 0; // listas no admitidas (primer pedido o demasiado grandes)
+};
+
+// Cache LRU delante de un arbol (que no debe cambiar mientras se usa). Tiene
+// dos niveles:
+// - conteos: patron -> countAll, hasta maxCounts entradas (baratas);
+// - listas: patron -> findAll, hasta listBudget bytes en total.
+// Admision: una lista entra solo si el patron ya estaba en el nivel de
+// conteos (se pidio antes) y ocupa a lo sumo maxListBytes, asi un patron raro
+// con millones de ocurrencias no barre el cache. No es seguro entre hilos.
+// findAll devuelve la lista compartida con el cache (un acierto no copia
+// posiciones); sigue valida aunque despues se desaloje.
+template <SuffixIndex Tree> class QueryCache {
+  public:
+    using Positions = decltype(std::declval<const Tree &>().findAll(std::string_view()));
+    using SharedPositions = std::shared_ptr<const Positions>;
+
+    explicit QueryCache(const Tree &t, size_t maxCounts = 1 << 16, size_t listBudget = 64 << 20,
+                        size_t maxListBytes = 1 << 20)
+        : tree(t), maxCounts(maxCounts), listBudget(listBudget), maxListBytes(maxListBytes) {}
+
+    // Usa los niveles solo si ya tienen el patron; si no, pregunta al arbol
+    // (O(|P|), sin contar ocurrencias) y no guarda nada.
+    bool contains(std::string_view P) {
+        if (auto *v = lists.get(P)) {
+            st.countHits++;
+            return !(*v)->empty();
+        }
+        if (int *c = counts.get(P)) {
+            st.countHits++;
+            return *c > 0;
+        }
+        st.countMisses++;
+        return tree.contains(P);
+    }
+
+    int countAll(std::string_view P) {
+        if (auto *v = lists.get(P)) {
+            st.countHits++;
+            return (int)(*v)->size();
+        }
+        if (int *c = counts.get(P)) {
+            st.countHits++;
+            return *c;
+        }
+        st.countMisses++;
+        int c = tree.countAll(P);
+        remember(P, c);
+        return c;
+    }
+
+    SharedPositions findAll(std::string_view P) {
+        if (auto *v = lists.get(P)) {
+            st.listHits++;
+            return *v;
+        }
+        st.listMisses++;
+
+        bool seen = counts.get(P) != nullptr;
+        SharedPositions res = std::make_shared<const Positions>(tree.findAll(P));
+        size_t bytes = res->size() * sizeof(typename Positions::value_type) + P.size();
+        if (seen && bytes <= maxListBytes) {
+            listBytes += bytes;
+            lists.put(P, res);
+            while (listBytes > listBudget) {
+                listBytes -= lists.oldest()->size() * sizeof(typename Positions::value_type) + lists.oldestKey().size();
+                lists.evict();
+                st.listEvictions++;
+            }
+        } else {
+            st.rejected++;
+            remember(P, (int)res->size());
+        }
+        return res;
+    }
+
+    const CacheStats &stats() const { return st; }
+    size_t bytes() const { return listBytes; }
+
+    void clear() {
+        counts = {};
+        lists = {};
+        listBytes = 0;
+    }
+
+  private:
+    // LRU generico: lista en orden de uso y mapa por string_view a la clave
+    // guardada en la lista (sin copias al buscar).
+    template <class V> struct Lru {
+        std::list<std::pair<std::string, V>> order;
+        std::unordered_map<std::string_view, typename decltype(order)::iterator> where;
+
+        V *get(std::string_view k) {
+            auto it = where.find(k);
+            if (it == where.end())
+                return nullptr;
+            order.splice(order.begin(), order, it->second);
+            return &it->second->second;
+        }
+
+        void put(std::string_view k, V v) {
+            order.emplace_front(std::string(k), std::move(v));
+            where[order.front().first] = order.begin();
+        }
+
+        const V &oldest() const { return order.back().second; }
+        const std::string &oldestKey() const { return order.back().first; }
+
+        void evict() {
+            where.erase(order.back().first);
+            order.pop_back();
+        }
+
+        size_t size() const { return order.size(); }
+    };
+
+    const Tree &tree;
+    size_t maxCounts, listBudget, maxListBytes;
+    size_t listBytes = 0;
+    Lru<int> counts;
+    Lru<SharedPositions> lists;
+    CacheStats st;
+
+    void remember(std::string_view P, int c) {
+        if (int *old = counts.get(P)) {
+            *old = c;
+            return;
+        }
+        counts.put(P, c);
+        if (counts.size() > maxCounts) {
+            counts.evict();
+            st.countEvictions++;
+        }
+    }
+};
+
+} // namespace suffixtree
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace suffixtree {
+
+// Protocolo binario del servidor de consultas (Server.cpp). Cada pedido es
+// una cabecera fija seguida del patron; cada respuesta, una cabecera seguida
+// de count posiciones uint64_t. Los campos van en el orden de bytes de la
+// maquina: el socket es local. El cliente puede mandar varios pedidos sin
+// esperar (pipelining); las respuestas llegan en el mismo orden, con el id
+// del pedido.
+enum QueryOp : uint32_t {
+    OpContains = 1,    // value = 0 o 1
+    OpCountAll = 2,    // value = ocurrencias
+    OpFindAll = 3,     // posiciones >= a ordenadas, a lo sumo b; la pagina
+                       // siguiente se pide con a = ultima + 1
+    OpSuffixArray = 4, // SA[a, a + b)
+    OpInfo = 5,        // value = largo del texto indexado (con su '$')
+};
+
+enum QueryStatus : uint32_t {
+    StatusOk = 0,
+    StatusBadRequest = 1,
+};
+
+struct RequestHeader {
+    uint32_t id = 0;
+    uint32_t op = 0;
+    uint64_t a = 0, b = 0;
+    uint32_t len = 0; // bytes de patron que siguen
+    uint32_t reserved = 0;
+};
+
+struct ResponseHeader {
+    uint32_t id = 0;
+    uint32_t status = StatusOk;
+    uint64_t value = 0;
+    uint64_t count = 0; // posiciones que siguen
+};
+
+static_assert(sizeof(RequestHeader) == 32 && sizeof(ResponseHeader) == 24);
+
+constexpr uint32_t kMaxPatternBytes = 1 << 20;
+constexpr uint64_t kMaxReplyPositions = 1 << 20;
+
+// Escribe len bytes completos; false si el otro extremo se fue.
+inline bool sendAll(int fd, const void *buf, size_t len) {
+    const char *p = (const char *)buf;
+    while (len > 0) {
+        ssize_t w = send(fd, p, len, MSG_NOSIGNAL);
+        if (w <= 0)
+            return false;
+        p += w;
+        len -= w;
+    }
+    return true;
+}
+
+// Lee len bytes completos; false si el otro extremo cerro antes.
+inline bool recvAll(int fd, void *buf, size_t len) {
+    char *p = (char *)buf;
+    while (len > 0) {
+        ssize_t r = read(fd, p, len);
+        if (r <= 0)
+            return false;
+        p += r;
+        len -= r;
+    }
+    return true;
+}
+
+inline void appendRequest(std::string &out, uint32_t id, QueryOp op, std::string_view P, uint64_t a = 0,
+                          uint64_t b = 0) {
+    RequestHeader h;
+    h.id = id;
+    h.op = op;
+    h.a = a;
+    h.b = b;
+    h.len = (uint32_t)P.size();
+    out.append((const char *)&h, sizeof h);
+    out.append(P);
+}
+
+inline bool readResponse(int fd, ResponseHeader &h, std::vector<uint64_t> &positions) {
+    if (!recvAll(fd, &h, sizeof h))
+        return false;
+    positions.resize(h.count);
+    return recvAll(fd, positions.data(), h.count * sizeof(uint64_t));
+}
+
+// Conexion de cliente al socket en path; -1 si no se pudo.
+inline int connectUnix(const std::string &path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof addr.sun_path - 1);
+    if (connect(fd, (sockaddr *)&addr, sizeof addr) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace suffixtree
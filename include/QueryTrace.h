@@ -0,0 +1,207 @@
+#pragma once
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+// Compilar con -DSUFFIX_TREE_TRACE para medir las consultas. Sin la bandera
+// los contadores y los cronometros desaparecen y el costo es cero; con la
+// bandera, un arbol sin enableQueryTrace() solo paga la prueba del puntero.
+#ifdef SUFFIX_TREE_TRACE
+#define ST_TRACE(field, n) (this->tracer ? (void)(::suffixtree::QueryTracer::current.field += (n)) : (void)0)
+#define ST_TRACE_SCOPE(method)                                                                                     \
+    ::suffixtree::QueryTraceScope stTraceScope_(this->tracer.get(), ::suffixtree::QueryMethod::method)
+#else
+#define ST_TRACE(field, n) ((void)0)
+#define ST_TRACE_SCOPE(method) ((void)0)
+#endif
+
+namespace suffixtree {
+
+// Histograma log-lineal (estilo HDR): valores exactos hasta 2^kSubBits y
+// despues 2^(kSubBits-1) baldes por potencia de dos, o sea un error relativo
+// de a lo sumo 1/16 en todo el rango de uint64_t con 976 baldes.
+class LatencyHistogram {
+  public:
+    static constexpr int kSubBits = 5;
+    static constexpr int kBuckets = (1 << kSubBits) + (64 - kSubBits) * (1 << (kSubBits - 1));
+
+    void record(uint64_t v) {
+        buckets[index(v)]++;
+        n++;
+        sum += v;
+        if (v > hi)
+            hi = v;
+    }
+
+    void merge(const LatencyHistogram &o) {
+        for (int i = 0; i < kBuckets; i++)
+            buckets[i] += o.buckets[i];
+        n += o.n;
+        sum += o.sum;
+        if (o.hi > hi)
+            hi = o.hi;
+    }
+
+    uint64_t count() const { return n; }
+    uint64_t max() const { return hi; }
+    double mean() const { return n ? (double)sum / n : 0; }
+
+    // mayor valor del balde donde cae el cuantil q (0 <= q <= 1)
+    uint64_t percentile(double q) const {
+        if (n == 0)
+            return 0;
+        uint64_t rank = (uint64_t)(q * (n - 1)) + 1, acc = 0;
+        for (int i = 0; i < kBuckets; i++) {
+            acc += buckets[i];
+            if (acc >= rank)
+                return upper(i) < hi ? upper(i) : hi;
+        }
+        return hi;
+    }
+
+  private:
+    uint64_t buckets[kBuckets] = {};
+    uint64_t n = 0, sum = 0, hi = 0;
+
+    static int index(uint64_t v) {
+        if (v < (uint64_t(1) << kSubBits))
+            return (int)v;
+        int shift = std::bit_width(v) - kSubBits;
+        int mant = (int)(v >> shift) - (1 << (kSubBits - 1));
+        return (1 << kSubBits) + (shift - 1) * (1 << (kSubBits - 1)) + mant;
+    }
+
+    static uint64_t upper(int i) {
+        if (i < (1 << kSubBits))
+            return (uint64_t)i;
+        int k = i - (1 << kSubBits);
+        int shift = k / (1 << (kSubBits - 1)) + 1;
+        uint64_t mant = (uint64_t)(k % (1 << (kSubBits - 1)) + (1 << (kSubBits - 1)));
+        return ((mant + 1) << shift) - 1;
+    }
+};
+
+// Trabajo de una consulta (o acumulado de varias).
+struct QueryCounters {
+    long long nodesVisited = 0; // nodos por los que paso el recorrido
+    long long edgeChars = 0;    // caracteres de arista comparados con el patron
+    long long leaves = 0;       // hojas entregadas
+    long long mapProbes = 0;    // busquedas en el mapa de hijos
+
+    QueryCounters &operator+=(const QueryCounters &o) {
+        nodesVisited += o.nodesVisited;
+        edgeChars += o.edgeChars;
+        leaves += o.leaves;
+        mapProbes += o.mapProbes;
+        return *this;
+    }
+
+    QueryCounters operator-(const QueryCounters &o) const {
+        return {nodesVisited - o.nodesVisited, edgeChars - o.edgeChars, leaves - o.leaves, mapProbes - o.mapProbes};
+    }
+};
+
+enum class QueryMethod { Contains, FindAll, CountAll, GetNodeFromPattern };
+
+// Distribucion por consulta de cada contador de QueryCounters (mismo
+// histograma que la latencia), para ver las colas y no solo la media.
+struct WorkHistograms {
+    LatencyHistogram nodesVisited, edgeChars, leaves, mapProbes;
+
+    void record(const QueryCounters &w) {
+        nodesVisited.record((uint64_t)w.nodesVisited);
+        edgeChars.record((uint64_t)w.edgeChars);
+        leaves.record((uint64_t)w.leaves);
+        mapProbes.record((uint64_t)w.mapProbes);
+    }
+};
+
+struct MethodTrace {
+    LatencyHistogram latencyNs;
+    QueryCounters work;      // suma de todas las llamadas
+    WorkHistograms perQuery; // una muestra por llamada
+};
+
+// Copia de lo medido hasta el momento, una entrada por QueryMethod.
+struct QueryTrace {
+    static constexpr int kMethods = 4;
+    static constexpr const char *kNames[kMethods] = {"contains", "findAll", "countAll", "getNodeFromPattern"};
+
+    MethodTrace methods[kMethods];
+
+    const MethodTrace &operator[](QueryMethod m) const { return methods[(int)m]; }
+
+    // una linea por metodo con llamadas, percentiles de latencia, trabajo
+    // medio por consulta y p99 de nodos y hojas por consulta
+    void dump(std::ostream &out) const {
+        for (int m = 0; m < kMethods; m++) {
+            const MethodTrace &t = methods[m];
+            uint64_t n = t.latencyNs.count();
+            if (n == 0)
+                continue;
+            out << kNames[m] << ": " << n << " llamadas, p50 " << t.latencyNs.percentile(0.5) << " ns, p99 "
+                << t.latencyNs.percentile(0.99) << " ns, max " << t.latencyNs.max() << " ns | por consulta: nodos "
+                << (double)t.work.nodesVisited / n << ", chars " << (double)t.work.edgeChars / n << ", hojas "
+                << (double)t.work.leaves / n << ", probes " << (double)t.work.mapProbes / n << " | p99 nodos "
+                << t.perQuery.nodesVisited.percentile(0.99) << ", p99 hojas " << t.perQuery.leaves.percentile(0.99)
+                << "\n";
+        }
+    }
+};
+
+// Acumula las mediciones de un arbol. Las consultas pueden venir de varios
+// hilos: cada hilo cuenta en su propio current y al cerrar la consulta se
+// vuelca el resultado bajo un mutex.
+class QueryTracer {
+  public:
+    static inline thread_local QueryCounters current;
+
+    void record(QueryMethod m, uint64_t ns, const QueryCounters &work) {
+        std::lock_guard<std::mutex> lock(mu);
+        trace.methods[(int)m].latencyNs.record(ns);
+        trace.methods[(int)m].work += work;
+        trace.methods[(int)m].perQuery.record(work);
+    }
+
+    QueryTrace snapshot() const {
+        std::lock_guard<std::mutex> lock(mu);
+        return trace;
+    }
+
+  private:
+    mutable std::mutex mu;
+    QueryTrace trace;
+};
+
+// Mide una llamada: tiempo y lo que crecio current entre la entrada y la
+// salida. Se anidan bien (contains cuenta tambien lo de getNodeFromPattern).
+class QueryTraceScope {
+  public:
+    QueryTraceScope(QueryTracer *t, QueryMethod m) : t(t), m(m) {
+        if (t) {
+            start = QueryTracer::current;
+            t0 = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~QueryTraceScope() {
+        if (t) {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0);
+            t->record(m, (uint64_t)ns.count(), QueryTracer::current - start);
+        }
+    }
+
+    QueryTraceScope(const QueryTraceScope &) = delete;
+    QueryTraceScope &operator=(const QueryTraceScope &) = delete;
+
+  private:
+    QueryTracer *t;
+    QueryMethod m;
+    QueryCounters start;
+    std::chrono::steady_clock::time_point t0;
+};
+
+} // namespace suffixtree
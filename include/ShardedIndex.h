@@ -0,0 +1,235 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "QueryProtocol.h"
+#include "SuffixIndex.h"
+#include "ThreadPool.h"
+
+namespace suffixtree {
+
+// Indice partido en shards: el texto se corta en tramos consecutivos y cada
+// shard indexa su tramo mas los maxPattern caracteres siguientes, asi toda
+// ocurrencia de un patron de hasta maxPattern caracteres queda entera en el
+// shard donde empieza. Cada shard responde solo por las ocurrencias que
+// empiezan en su tramo propio, de modo que las del solapamiento no se cuentan
+// dos veces.
+//
+// Los shards son hilos de este proceso (Mode::Threads, un ThreadPool) o
+// procesos hijos (Mode::Processes, fork + socketpair). El coordinador manda
+// cada consulta a todos los shards y junta las respuestas con posiciones
+// globales. Despachar a todos cuesta del orden de microsegundos por consulta;
+// conviene cuando cada shard hace trabajo real (textos grandes, findAll).
+// Un patron de mas de maxPattern caracteres no se puede responder (podria
+// cruzar dos shards): no se despacha y da false, 0 o una lista vacia; quien
+// atiende clientes lo detecta antes con accepts(P) y reporta el error.
+template <SuffixIndex Tree = LcpSuffixTree> class ShardedIndex {
+  public:
+    enum class Mode { Threads, Processes };
+
+    ShardedIndex(std::string_view text, int shards, size_t maxPattern, Mode mode = Mode::Threads)
+        : maxLen(std::max<size_t>(1, maxPattern)), mode(mode) {
+        if (!text.empty() && text.back() == '$')
+            text.remove_suffix(1);
+        n = text.size();
+        shards = std::max(1, shards);
+        uint64_t own = (n + shards - 1) / shards;
+
+        std::vector<Shard> parts(shards);
+        for (int i = 0; i < shards; i++) {
+            parts[i].begin = std::min<uint64_t>(n, i * own);
+            parts[i].own = std::min<uint64_t>(n, parts[i].begin + own) - parts[i].begin;
+        }
+
+        auto build = [&](int i) {
+            Shard &sh = parts[i];
+            std::string_view chunk = text.substr(sh.begin, sh.own + maxLen);
+            sh.tree.build(std::string(chunk) + '$');
+        };
+
+        if (mode == Mode::Threads) {
+            pool = std::make_unique<ThreadPool>(std::min(shards, (int)std::thread::hardware_concurrency()));
+            pool->parallelFor(shards, build);
+            local = std::move(parts);
+            return;
+        }
+
+        // cada hijo construye su shard y atiende consultas por su socket
+        for (int i = 0; i < shards; i++) {
+            int sv[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+                perror("socketpair");
+                std::exit(1);
+            }
+            pid_t pid = fork();
+            if (pid < 0) {
+                perror("fork");
+                std::exit(1);
+            }
+            if (pid == 0) {
+                close(sv[0]);
+                for (const Peer &p : peers)
+                    close(p.fd);
+                build(i);
+                serve(parts[i], sv[1]);
+                _exit(0);
+            }
+            close(sv[1]);
+            peers.push_back({pid, sv[0]});
+        }
+    }
+
+    ShardedIndex(const ShardedIndex &) = delete;
+    ShardedIndex &operator=(const ShardedIndex &) = delete;
+
+    ~ShardedIndex() {
+        for (const Peer &p : peers) {
+            close(p.fd); // el hijo lee fin de archivo y termina
+            waitpid(p.pid, nullptr, 0);
+        }
+    }
+
+    int shards() const { return mode == Mode::Threads ? (int)local.size() : (int)peers.size(); }
+    size_t maxPattern() const { return maxLen; }
+    uint64_t size() const { return n; }
+
+    // false si P es mas largo que maxPattern y las consultas no lo responden
+    bool accepts(std::string_view P) const { return P.size() <= maxLen; }
+
+    bool contains(std::string_view P) const {
+        bool found = false;
+        for (const Reply &r : gather('h', P))
+            found = found || r.count > 0;
+        return found;
+    }
+
+    uint64_t countAll(std::string_view P) const {
+        uint64_t total = 0;
+        for (const Reply &r : gather('c', P))
+            total += r.count;
+        return total;
+    }
+
+    // Posiciones globales en orden creciente.
+    std::vector<uint64_t> findAll(std::string_view P) const {
+        std::vector<Reply> replies = gather('f', P);
+        size_t total = 0;
+        for (const Reply &r : replies)
+            total += r.positions.size();
+        std::vector<uint64_t> res;
+        res.reserve(total);
+        for (const Reply &r : replies)
+            res.insert(res.end(), r.positions.begin(), r.positions.end());
+        return res;
+    }
+
+  private:
+    struct Shard {
+        uint64_t begin = 0; // posicion global del primer caracter
+        uint64_t own = 0;   // responde por las ocurrencias en [begin, begin + own)
+        Tree tree;
+    };
+
+    struct Peer {
+        pid_t pid;
+        int fd;
+    };
+
+    struct Reply {
+        uint64_t count = 0;
+        std::vector<uint64_t> positions;
+    };
+
+    size_t maxLen;
+    Mode mode;
+    uint64_t n = 0;
+    std::vector<Shard> local;
+    std::unique_ptr<ThreadPool> pool;
+    std::vector<Peer> peers;
+
+    // op: 'h' contains, 'c' countAll, 'f' findAll
+    static Reply answer(const Shard &sh, char op, std::string_view P) {
+        Reply r;
+        if (op == 'h') {
+            r.count = sh.tree.contains(P);
+        } else if (op == 'c') {
+            // las que empiezan en el solapamiento son del shard siguiente
+            sh.tree.forEachMatch(P, [&](auto pos) {
+                r.count += (uint64_t)pos < sh.own;
+                return true;
+            });
+        } else {
+            for (auto p : sh.tree.findAll(P))
+                if ((uint64_t)p < sh.own)
+                    r.positions.push_back(sh.begin + p);
+            std::sort(r.positions.begin(), r.positions.end());
+            r.count = r.positions.size();
+        }
+        return r;
+    }
+
+    std::vector<Reply> gather(char op, std::string_view P) const {
+        if (!accepts(P))
+            return {};
+        std::vector<Reply> replies(shards());
+        if (mode == Mode::Threads) {
+            pool->parallelFor(shards(), [&](int i) { replies[i] = answer(local[i], op, P); });
+            return replies;
+        }
+
+        // primero todos los pedidos, despues las respuestas en orden
+        for (size_t i = 0; i < peers.size(); i++) {
+            uint32_t len = (uint32_t)P.size();
+            if (!sendAll(peers[i].fd, &op, 1) || !sendAll(peers[i].fd, &len, sizeof len) ||
+                !sendAll(peers[i].fd, P.data(), len)) {
+                std::cerr << "Error: el shard " << i << " no responde\n";
+                std::exit(1);
+            }
+        }
+        for (size_t i = 0; i < peers.size(); i++) {
+            Reply &r = replies[i];
+            bool ok = recvAll(peers[i].fd, &r.count, sizeof r.count);
+            if (ok && op == 'f') {
+                r.positions.resize(r.count);
+                ok = recvAll(peers[i].fd, r.positions.data(), r.count * sizeof(uint64_t));
+            }
+            if (!ok) {
+                std::cerr << "Error: el shard " << i << " no respondio\n";
+                std::exit(1);
+            }
+        }
+        return replies;
+    }
+
+    // bucle del proceso hijo: pedido = op, largo (uint32_t) y patron
+    static void serve(const Shard &sh, int fd) {
+        std::string P;
+        char op;
+        uint32_t len;
+        while (recvAll(fd, &op, 1) && recvAll(fd, &len, sizeof len)) {
+            P.resize(len);
+            if (!recvAll(fd, P.data(), len))
+                break;
+            Reply r = answer(sh, op, P);
+            if (!sendAll(fd, &r.count, sizeof r.count) ||
+                (op == 'f' && !sendAll(fd, r.positions.data(), r.positions.size() * sizeof(uint64_t))))
+                break;
+        }
+    }
+};
+
+} // namespace suffixtree
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "LcpSuffixTree.h"
+#include "SuffixArray.h"
+
+namespace suffixtree {
+
+inline bool isWordSeparator(unsigned char c) { return std::isspace(c) || std::ispunct(c); }
+
+// Posiciones donde empieza una palabra: la 0 y las que siguen a un espacio o
+// signo de puntuacion, sin contar el '$' final.
+inline std::vector<int> wordStarts(const std::string &s) {
+    int n = (int)s.size();
+    if (n > 0 && s.back() == '$')
+        n--;
+
+    std::vector<int> starts;
+    for (int i = 0; i < n; i++)
+        if (!isWordSeparator(s[i]) && (i == 0 || isWordSeparator(s[i - 1])))
+            starts.push_back(i);
+    return starts;
+}
+
+// Arbol de sufijos disperso: solo indexa los sufijos que empiezan en starts
+// (por defecto, inicios de palabra). contains/findAll tienen la misma
+// semantica pero restringida a esas posiciones, con muchos menos nodos.
+//
+// Se filtra el arreglo de sufijos completo quedandose con esos sufijos; el LCP
+// entre dos consecutivos es el minimo del LCP completo entre ellos. El resto
+// es la construccion por pila de LcpSuffixTree.
+class SparseSuffixTree : public LcpSuffixTree {
+  public:
+    SparseSuffixTree() = default;
+    explicit SparseSuffixTree(std::string text) { build(std::move(text)); }
+    SparseSuffixTree(std::string text, const std::vector<int> &starts) { build(std::move(text), starts); }
+
+    void build(std::string text) {
+        if (text.empty() || text.back() != '$')
+            text.push_back('$');
+        std::vector<int> starts = wordStarts(text);
+        build(std::move(text), starts);
+    }
+
+    // starts: posiciones a indexar dentro de text (sin repetir, en cualquier orden)
+    void build(std::string text, const std::vector<int> &starts) {
+        if (text.empty() || text.back() != '$')
+            text.push_back('$');
+        int n = (int)text.size();
+
+        std::vector<char> keep(n, 0);
+        for (int p : starts)
+            if (p >= 0 && p < n)
+                keep[p] = 1;
+
+        std::vector<Pos> SA = buildSuffixArray<Pos>(text);
+        std::vector<Pos> LCP = buildLcp(text, SA);
+
+        // compactar en el lugar: SA[m] y LCP[m] quedan con los sufijos elegidos
+        size_t m = 0;
+        Pos run = 0;
+        for (int i = 0; i < n; i++) {
+            run = (m == 0) ? 0 : std::min(run, LCP[i]);
+            if (keep[SA[i]]) {
+                LCP[m] = run;
+                SA[m++] = SA[i];
+                run = (Pos)n;
+            }
+        }
+        SA.resize(m);
+        LCP.resize(m);
+        SA.shrink_to_fit();
+        LCP.shrink_to_fit();
+
+        LcpSuffixTree::build(std::move(text), SA, LCP);
+    }
+};
+
+static_assert(SuffixIndex<SparseSuffixTree> && NodeTraversable<SparseSuffixTree>);
+
+} // namespace suffixtree
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace suffixtree {
+
+// Arreglo de sufijos por duplicacion de prefijos con counting sort,
+// O(n log n). Seq es cualquier secuencia de simbolos enteros no negativos
+// (std::string se lee como unsigned char). Se asume, como en el resto del
+// repo, que el ultimo simbolo es un terminador unico. Idx es el tipo de las
+// posiciones: alcanza con uint32_t hasta 4 GB de texto.
+template <class Idx = int, class Seq> std::vector<Idx> buildSuffixArray(const Seq &t) {
+    int64_t n = (int64_t)t.size();
+    std::vector<Idx> sa(n), rk(n), tmp(n);
+    if (n == 0)
+        return sa;
+
+    auto sym = [&](int64_t i) { return (int64_t)(std::make_unsigned_t<std::decay_t<decltype(t[i])>>)t[i]; };
+
+    int64_t classes = 0;
+    for (int64_t i = 0; i < n; i++)
+        classes = std::max(classes, sym(i) + 1);
+
+    std::vector<Idx> cnt(std::max(classes, n) + 1, 0);
+    for (int64_t i = 0; i < n; i++)
+        cnt[sym(i)]++;
+    for (int64_t c = 1; c < classes; c++)
+        cnt[c] += cnt[c - 1];
+    for (int64_t i = n - 1; i >= 0; i--)
+        sa[--cnt[sym(i)]] = (Idx)i;
+
+    rk[sa[0]] = 0;
+    classes = 1;
+    for (int64_t i = 1; i < n; i++) {
+        if (sym(sa[i]) != sym(sa[i - 1]))
+            classes++;
+        rk[sa[i]] = (Idx)(classes - 1);
+    }
+
+    for (int64_t k = 1; classes < n; k <<= 1) {
+        // orden por la segunda mitad: los que no la tienen van primero
+        int64_t p = 0;
+        for (int64_t i = n - k; i < n; i++)
+            tmp[p++] = (Idx)i;
+        for (int64_t i = 0; i < n; i++)
+            if ((int64_t)sa[i] >= k)
+                tmp[p++] = (Idx)(sa[i] - k);
+
+        // orden estable por la primera mitad
+        std::fill(cnt.begin(), cnt.begin() + classes, 0);
+        for (int64_t i = 0; i < n; i++)
+            cnt[rk[i]]++;
+        for (int64_t c = 1; c < classes; c++)
+            cnt[c] += cnt[c - 1];
+        for (int64_t i = n - 1; i >= 0; i--)
+            sa[--cnt[rk[tmp[i]]]] = tmp[i];
+
+        auto second = [&](int64_t i) { return i + k < n ? (int64_t)rk[i + k] : -1; };
+        tmp[sa[0]] = 0;
+        classes = 1;
+        for (int64_t i = 1; i < n; i++) {
+            if (rk[sa[i]] != rk[sa[i - 1]] || second(sa[i]) != second(sa[i - 1]))
+                classes++;
+            tmp[sa[i]] = (Idx)(classes - 1);
+        }
+        rk.swap(tmp);
+    }
+    return sa;
+}
+
+// LCP de Kasai, O(n): lcp[i] es el prefijo comun entre SA[i-1] y SA[i]
+// (lcp[0] = 0).
+template <class Seq, class Idx> std::vector<Idx> buildLcp(const Seq &t, const std::vector<Idx> &sa) {
+    int64_t n = (int64_t)t.size();
+    std::vector<Idx> rank(n), lcp(n, 0);
+    for (int64_t i = 0; i < n; i++)
+        rank[sa[i]] = (Idx)i;
+
+    int64_t h = 0;
+    for (int64_t i = 0; i < n; i++) {
+        if (rank[i] == 0) {
+            h = 0;
+            continue;
+        }
+        int64_t j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && t[i + h] == t[j + h])
+            h++;
+        lcp[rank[i]] = (Idx)h;
+        if (h > 0)
+            h--;
+    }
+    return lcp;
+}
+
+} // namespace suffixtree
@@ -0,0 +1,722 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "KmerJumpTable.h"
+#include "NodePool.h"
+#include "QGramFilter.h"
+#include "QueryTrace.h"
+#include "ThreadPool.h"
+#include "WaveletMatrix.h"
+
+// Compilar con -DSUFFIX_TREE_STATS para contar el trabajo de construccion.
+// Sin la bandera los contadores no se tocan y el costo es cero.
+#ifdef SUFFIX_TREE_STATS
+#define ST_COUNT(field, n) (this->stats.field += (n))
+#else
+#define ST_COUNT(field, n) ((void)0)
+#endif
+
+namespace suffixtree {
+
+// vector de posiciones; el tipo entero depende del motor (int, uint32_t, ...)
+template <class V>
+concept PositionList = std::same_as<V, std::vector<typename V::value_type>> && std::integral<typename V::value_type>;
+
+// Interfaz comun de los motores. Se resuelve en compilacion: quien recibe un
+// SuffixIndex puede cambiar de motor sin pagar despacho virtual.
+template <class T>
+concept SuffixIndex = requires(T t, std::string text, std::string_view P) {
+    t.build(text);
+    { t.contains(P) } -> std::convertible_to<bool>;
+    { t.findAll(P) } -> PositionList;
+    { t.countAll(P) } -> std::convertible_to<int>;
+    { t.toSuffixArray() } -> PositionList;
+};
+
+// Arbol de caracteres que se deja recorrer desde afuera nodo a nodo (lo que
+// usan los recorridos con comodines de WildcardPattern.h): aristas que son
+// rangos [start, start + len()) de s, hijos por caracter y hojas bajo un
+// nodo. Los motores de SuffixTreeBase lo cumplen; WordSuffixTree (aristas de
+// palabras) y NormalizedSuffixTree (sin nodos propios) no.
+template <class T>
+concept NodeTraversable =
+    SuffixIndex<T> && requires(const T t, typename T::Node *v, unsigned char c, bool (*f)(typename T::Pos)) {
+        { t.s } -> std::convertible_to<const std::string &>;
+        { t.root } -> std::convertible_to<typename T::Node *>;
+        { t.child(v, c) } -> std::convertible_to<typename T::Node *>;
+        { v->start } -> std::convertible_to<size_t>;
+        { v->len() } -> std::convertible_to<size_t>;
+        { v->next.begin()->first } -> std::convertible_to<unsigned char>;
+        { v->next.begin()->second } -> std::convertible_to<typename T::Node *>;
+        { t.forEachLeaf(v, f) } -> std::same_as<bool>;
+    };
+
+struct BuildStats {
+    long long splits = 0;        // nodos internos creados al partir una arista
+    long long leaves = 0;        // hojas creadas
+    long long linkHops = 0;      // saltos por suffix link
+    long long walkDownSkips = 0; // aristas completas saltadas (walk-down/rescan)
+    long long charsCompared = 0; // comparaciones de caracteres del texto
+    long long mapProbes = 0;     // busquedas/inserciones en el mapa de hijos
+};
+
+struct NodeCounts {
+    long long internal = 0;
+    long long leaves = 0;
+    long long buckets = 0; // buckets de los unordered_map de hijos
+};
+
+// Base CRTP con todo lo que no depende del algoritmo de construccion.
+// Derived implementa build(string) y guarda sus nodos en pool; cada Node
+// expone next (hijo por primer caracter), start, len() y suffixIndex. El tipo
+// de suffixIndex es el de las posiciones que devuelven las consultas.
+template <class Derived, class NodeT> class SuffixTreeBase {
+  public:
+    using Node = NodeT;
+    using Pos = std::remove_cvref_t<decltype(std::declval<NodeT &>().suffixIndex)>;
+
+    std::string s;
+    Node *root = nullptr;
+    NodePool<Node> pool;
+
+    // true si next ya itera los hijos en orden de caracter
+    static constexpr bool kSortedChildren = false;
+
+    Node *child(const Node *v, unsigned char c) const {
+        auto it = v->next.find(c);
+        return it == v->next.end() ? nullptr : it->second;
+    }
+
+    bool contains(std::string_view P) const {
+        ST_TRACE_SCOPE(Contains);
+        return self().getNodeFromPattern(P) != nullptr;
+    }
+
+    // Tabla opcional para saltar los primeros k niveles en cada consulta.
+    // Se descarta al reconstruir. Devuelve el k efectivo.
+    int enableJumpTable(int k) {
+        jump = std::make_unique<KmerJumpTable<Node>>();
+        return jump->build(s, root, k);
+    }
+
+    void disableJumpTable() { jump.reset(); }
+
+    size_t jumpTableBytes() const { return jump ? jump->bytes() : 0; }
+
+    // Filtro opcional de q-gramas para rechazar de inmediato patrones que no
+    // aparecen. budgetBytes acota su memoria. Se descarta al reconstruir.
+    void enableFilter(int q, size_t budgetBytes, int hashes = 2) {
+        filter = std::make_unique<QGramFilter>();
+        filter->build(s, q, budgetBytes, hashes);
+    }
+
+    void disableFilter() { filter.reset(); }
+
+    size_t filterBytes() const { return filter ? filter->bytes() : 0; }
+
+    // Indice opcional (arreglo de sufijos + wavelet matrix) para findAll y
+    // countAll restringidos a un rango de posiciones. Se descarta al reconstruir.
+    void enableRangeQueries() {
+        ranges = std::make_unique<PositionRangeIndex<Pos>>();
+        ranges->build(self().toSuffixArray());
+    }
+
+    void disableRangeQueries() { ranges.reset(); }
+
+    size_t rangeIndexBytes() const { return ranges ? ranges->bytes() : 0; }
+
+    // Histogramas de latencia y contadores de trabajo por metodo (contains,
+    // findAll, countAll, getNodeFromPattern). Solo miden si se compilo con
+    // SUFFIX_TREE_TRACE; si no, queryTrace() queda vacio.
+    void enableQueryTrace() { tracer = std::make_unique<QueryTracer>(); }
+
+    void disableQueryTrace() { tracer.reset(); }
+
+    QueryTrace queryTrace() const { return tracer ? tracer->snapshot() : QueryTrace(); }
+
+    // false solo si el filtro garantiza que P no aparece
+    bool mayContain(std::string_view P) const { return !filter || filter->mayContain(P); }
+
+    Node *getNodeFromPattern(std::string_view P) const {
+        ST_TRACE_SCOPE(GetNodeFromPattern);
+        if (filter && !filter->mayContain(P))
+            return nullptr;
+
+        Node *v = root;
+        size_t i = 0;
+
+        if (jump && P.size() >= (size_t)jump->kmer()) {
+            auto loc = jump->find(P);
+            if (!loc.node)
+                return nullptr;
+
+            // terminar la arista donde dejo la tabla
+            i = jump->kmer();
+            ST_TRACE(nodesVisited, 1);
+            for (size_t j = loc.offset; j < (size_t)loc.node->len() && i < P.size(); j++, i++) {
+                ST_TRACE(edgeChars, 1);
+                if (s[loc.node->start + j] != P[i])
+                    return nullptr;
+            }
+            v = loc.node;
+        }
+
+        while (i < P.size()) {
+            Node *nxt = self().child(v, P[i]);
+            ST_TRACE(mapProbes, 1);
+            if (!nxt)
+                return nullptr;
+            ST_TRACE(nodesVisited, 1);
+
+            size_t edgeLen = nxt->len();
+            size_t j = 0;
+
+            while (j < edgeLen && i < P.size()) {
+                ST_TRACE(edgeChars, 1);
+                if (s[nxt->start + j] != P[i])
+                    return nullptr;
+                j++;
+                i++;
+            }
+
+            v = nxt;
+        }
+
+        return v;
+    }
+
+    // contains para un lote de patrones (cualquier secuencia de algo
+    // convertible a string_view). Mantiene G recorridos en vuelo y avanza cada
+    // uno un paso por turno: antes de ceder pide con prefetch el nodo o el
+    // texto de la arista que va a leer, y cuando le vuelve el turno ya esta en
+    // cache (AMAC). En vez de esperar cada fallo de cache se atiende a otro.
+    template <int G = 16, class Seq> std::vector<char> containsBatch(const Seq &patterns) const {
+        struct Lookup {
+            std::string_view p;
+            size_t idx;
+            Node *v, *nxt;
+            size_t i, j;
+            int stage; // 0: buscar hijo, 1: leer arista, 2: comparar
+        };
+
+        size_t n = std::size(patterns);
+        std::vector<char> res(n, 0);
+        Lookup ring[G];
+        auto it = std::begin(patterns);
+        size_t fed = 0;
+
+        // devuelve false si la respuesta ya se conoce (queda en res)
+        auto start = [&](Lookup &L) {
+            L = {std::string_view(*it++), fed++, root, nullptr, 0, 0, 0};
+            if (filter && !filter->mayContain(L.p))
+                return false;
+            if (jump && L.p.size() >= (size_t)jump->kmer()) {
+                auto loc = jump->find(L.p);
+                if (!loc.node)
+                    return false;
+                L.nxt = loc.node;
+                L.i = jump->kmer();
+                L.j = loc.offset;
+                L.stage = 1;
+                __builtin_prefetch(loc.node);
+            }
+            return true;
+        };
+        auto refill = [&](Lookup &L) {
+            while (fed < n) {
+                if (start(L))
+                    return true;
+            }
+            return false;
+        };
+
+        int live = 0;
+        bool busy[G] = {};
+        for (int g = 0; g < G && refill(ring[g]); g++) {
+            busy[g] = true;
+            live++;
+        }
+
+        while (live > 0) {
+            for (int g = 0; g < G; g++) {
+                if (!busy[g])
+                    continue;
+                Lookup &L = ring[g];
+                size_t m = L.p.size();
+                int found = -1; // -1: sigue, 0/1: respuesta
+
+                if (L.stage == 0) {
+                    if (L.i == m) {
+                        found = 1;
+                    } else if (!(L.nxt = self().child(L.v, L.p[L.i]))) {
+                        found = 0;
+                    } else {
+                        L.j = 0;
+                        L.stage = 1;
+                        __builtin_prefetch(L.nxt);
+                    }
+                } else if (L.stage == 1) {
+                    __builtin_prefetch(s.data() + L.nxt->start + L.j);
+                    L.stage = 2;
+                } else {
+                    size_t len = L.nxt->len();
+                    while (L.j < len && L.i < m && s[L.nxt->start + L.j] == L.p[L.i]) {
+                        L.j++;
+                        L.i++;
+                    }
+                    if (L.j < len && L.i < m) {
+                        found = 0;
+                    } else if (L.i == m) {
+                        found = 1;
+                    } else {
+                        L.v = L.nxt;
+                        L.stage = 0;
+                        if constexpr (requires { L.v->next.data(); })
+                            __builtin_prefetch(L.v->next.data());
+                    }
+                }
+
+                if (found >= 0) {
+                    res[L.idx] = (char)found;
+                    if (!refill(L)) {
+                        busy[g] = false;
+                        live--;
+                    }
+                }
+            }
+        }
+        return res;
+    }
+
+    void DFS(Node *node, std::vector<Pos> &indices) const {
+        forEachLeaf(node, [&](Pos pos) {
+            indices.push_back(pos);
+            return true;
+        });
+    }
+
+    template <class F> bool forEachLeaf(Node *node, F &&f) const {
+        ST_TRACE(nodesVisited, 1);
+        if (node->next.empty()) {
+            ST_TRACE(leaves, 1);
+            return f(node->suffixIndex);
+        }
+
+        for (auto &kv : node->next) {
+            if (!forEachLeaf(kv.second, f))
+                return false;
+        }
+        return true;
+    }
+
+    std::vector<Pos> findAll(std::string_view P) const {
+        ST_TRACE_SCOPE(FindAll);
+        std::vector<Pos> indices;
+        forEachMatch(P, [&](Pos pos) {
+            indices.push_back(pos);
+            return true;
+        });
+        return indices;
+    }
+
+    // findAll con el recorrido repartido en workers; mismo resultado y mismo
+    // orden que findAll(P). Cada tarea junta las hojas de un subarbol en su
+    // propio bloque y despues los bloques se copian en paralelo a su
+    // desplazamiento en la salida, sin locks.
+    std::vector<Pos> findAll(std::string_view P, ThreadPool &workers) const {
+        Node *v = self().getNodeFromPattern(P);
+        if (!v)
+            return {};
+        return collectParallel(v, workers, false);
+    }
+
+    // Recorre las ocurrencias de P sin reservar memoria. f(pos) devuelve
+    // false para cortar el recorrido. Retorna false si se corto antes de terminar.
+    template <class F> bool forEachMatch(std::string_view P, F &&f) const {
+        Node *v = self().getNodeFromPattern(P);
+        if (!v)
+            return true;
+        return forEachLeaf(v, f);
+    }
+
+    // Escribe en out las ocurrencias de P saltando las primeras offset y
+    // deteniendose tras limit resultados (orden del recorrido, no de posicion).
+    template <class OutIt> OutIt findAll(std::string_view P, OutIt out, size_t offset, size_t limit) const {
+        if (limit == 0)
+            return out;
+        forEachMatch(P, [&](Pos pos) {
+            if (offset > 0) {
+                offset--;
+                return true;
+            }
+            *out++ = pos;
+            return --limit > 0;
+        });
+        return out;
+    }
+
+    // Las ocurrencias de P ordenadas por posicion, paginadas con offset/limit.
+    // buf debe tener espacio para offset + limit enteros: se usa como max-heap
+    // de las menores posiciones, asi que no hay reservas de memoria.
+    // Retorna la cantidad de posiciones escritas al inicio de buf.
+    size_t findAllSorted(std::string_view P, Pos *buf, size_t offset, size_t limit) const {
+        size_t cap = offset + limit;
+        if (limit == 0)
+            return 0;
+
+        size_t cnt = 0;
+        forEachMatch(P, [&](Pos pos) {
+            if (cnt < cap) {
+                buf[cnt++] = pos;
+                std::push_heap(buf, buf + cnt);
+            } else if (pos < buf[0]) {
+                std::pop_heap(buf, buf + cnt);
+                buf[cnt - 1] = pos;
+                std::push_heap(buf, buf + cnt);
+            }
+            return true;
+        });
+        std::sort_heap(buf, buf + cnt);
+
+        if (cnt <= offset)
+            return 0;
+        std::copy(buf + offset, buf + cnt, buf);
+        return cnt - offset;
+    }
+
+    int countAll(std::string_view P) const {
+        ST_TRACE_SCOPE(CountAll);
+        int cnt = 0;
+        forEachMatch(P, [&](Pos) {
+            cnt++;
+            return true;
+        });
+        return cnt;
+    }
+
+    // Ocurrencias de P que empiezan en [lo, hi), ordenadas por posicion. Con
+    // enableRangeQueries() cuestan O(|P| log n) mas O(log n) por resultado y
+    // no tocan las de afuera; sin el indice se filtra el recorrido completo.
+    std::vector<Pos> findAll(std::string_view P, uint64_t lo, uint64_t hi) const {
+        std::vector<Pos> res;
+        if (!mayContain(P))
+            return res;
+        if (ranges) {
+            ranges->report(s, P, lo, hi, [&](Pos pos) {
+                res.push_back(pos);
+                return true;
+            });
+            return res;
+        }
+        forEachMatch(P, [&](Pos pos) {
+            if ((uint64_t)pos >= lo && (uint64_t)pos < hi)
+                res.push_back(pos);
+            return true;
+        });
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    int countAll(std::string_view P, uint64_t lo, uint64_t hi) const {
+        if (!mayContain(P))
+            return 0;
+        if (ranges)
+            return (int)ranges->count(s, P, lo, hi);
+        int cnt = 0;
+        forEachMatch(P, [&](Pos pos) {
+            cnt += (uint64_t)pos >= lo && (uint64_t)pos < hi;
+            return true;
+        });
+        return cnt;
+    }
+
+    bool findPathTo(Node *cur, Node *target, std::string &acc) const {
+        if (cur == target)
+            return true;
+
+        for (auto &kv : cur->next) {
+            Node *to = kv.second;
+            size_t oldSize = acc.size();
+            acc.append(s, to->start, to->len());
+            if (findPathTo(to, target, acc))
+                return true;
+            acc.resize(oldSize);
+        }
+        return false;
+    }
+
+    std::string pathLabel(Node *v) const {
+        std::string acc;
+        findPathTo(root, v, acc);
+        return acc;
+    }
+
+    int stringDepth(Node *v) const { return (int)self().pathLabel(v).size(); }
+
+    void dfsSuffixArray(Node *v, std::vector<Pos> &SA) const {
+        if (v->next.empty()) {
+            SA.push_back(v->suffixIndex);
+            return;
+        }
+
+        if constexpr (Derived::kSortedChildren) {
+            for (auto &kv : v->next)
+                dfsSuffixArray(kv.second, SA);
+        } else {
+            std::vector<std::pair<unsigned char, Node *>> children(v->next.begin(), v->next.end());
+            std::sort(children.begin(), children.end(),
+                      [](const auto &a, const auto &b) { return a.first < b.first; });
+
+            for (auto &kv : children)
+                dfsSuffixArray(kv.second, SA);
+        }
+    }
+
+    std::vector<Pos> toSuffixArray() const {
+        std::vector<Pos> SA;
+        SA.reserve(s.size());
+        dfsSuffixArray(root, SA);
+        return SA;
+    }
+
+    std::vector<Pos> toSuffixArray(ThreadPool &workers) const { return collectParallel(root, workers, true); }
+
+    // SA, LCP, BWT e ISA en un solo recorrido, escritos en buffers del que
+    // llama (pueden ser memoria mapeada); cualquiera puede ser nullptr. SA,
+    // LCP y BWT tienen una entrada por hoja (s.size() en un arbol completo) e
+    // ISA una por posicion de s. LCP[i] es la profundidad de cadena del nodo
+    // donde se separan las hojas i-1 e i (LCP[0] = 0). La pila es la unica
+    // memoria y se reutiliza: no hay reservas por nodo. Devuelve las hojas.
+    size_t exportArrays(Pos *SA, Pos *LCP, char *BWT, Pos *ISA) const {
+        struct Item {
+            Node *v;
+            Pos lcp;   // LCP de la primera hoja del subarbol con la anterior
+            Pos depth; // profundidad de cadena del padre de v
+        };
+        std::vector<Item> stack = {{root, 0, 0}};
+        size_t k = 0;
+
+        while (!stack.empty()) {
+            Item it = stack.back();
+            stack.pop_back();
+
+            if (it.v->next.empty()) {
+                Pos suf = it.v->suffixIndex;
+                if (SA)
+                    SA[k] = suf;
+                if (LCP)
+                    LCP[k] = it.lcp;
+                if (BWT)
+                    BWT[k] = suf == 0 ? s.back() : s[(size_t)suf - 1];
+                if (ISA)
+                    ISA[(size_t)suf] = (Pos)k;
+                k++;
+                continue;
+            }
+
+            // hijos en orden inverso para sacarlos en orden; el primero hereda
+            // el LCP pendiente y los demas se separan en esta profundidad
+            // (los nodos se piden con prefetch al apilarlos: se leen al sacarlos)
+            Pos depth = it.v == root ? 0 : (Pos)(it.depth + it.v->len());
+            if constexpr (Derived::kSortedChildren) {
+                for (auto c = it.v->next.rbegin(); c != it.v->next.rend(); ++c) {
+                    __builtin_prefetch(c->second);
+                    stack.push_back({c->second, depth, depth});
+                }
+            } else {
+                size_t first = stack.size();
+                for (auto &kv : it.v->next) {
+                    __builtin_prefetch(kv.second);
+                    stack.push_back({kv.second, depth, depth});
+                }
+                std::sort(stack.begin() + first, stack.end(), [&](const Item &a, const Item &b) {
+                    return (unsigned char)s[a.v->start] > (unsigned char)s[b.v->start];
+                });
+            }
+            stack.back().lcp = it.lcp;
+        }
+        return k;
+    }
+
+    const BuildStats &buildStats() const { return stats; }
+
+    NodeCounts nodeCounts() const {
+        NodeCounts c;
+        for (Node *v : pool) {
+            if (v->next.empty())
+                c.leaves++;
+            else
+                c.internal++;
+            if constexpr (requires { v->next.bucket_count(); })
+                c.buckets += v->next.bucket_count();
+        }
+        return c;
+    }
+
+    void print() const { printRec(root, "", true); }
+
+  protected:
+    BuildStats stats;
+    std::unique_ptr<KmerJumpTable<Node>> jump;
+    std::unique_ptr<QGramFilter> filter;
+    std::unique_ptr<PositionRangeIndex<Pos>> ranges;
+    std::unique_ptr<QueryTracer> tracer;
+
+    // Deja el texto listo para construir: agrega el terminador y limpia el arbol.
+    void reset(std::string text) {
+        if (text.empty() || text.back() != '$')
+            text.push_back('$');
+        s = std::move(text);
+        pool.clear();
+        jump.reset();
+        filter.reset();
+        ranges.reset();
+        stats = BuildStats();
+    }
+
+    template <class... Args> Node *makeNode(Args &&...args) {
+        return pool.make(std::forward<Args>(args)...);
+    }
+
+  private:
+    const Derived &self() const { return static_cast<const Derived &>(*this); }
+
+    // Reemplaza nodos internos por sus hijos, nivel por nivel, hasta tener al
+    // menos target subarboles. Quedan en el orden del recorrido (por caracter
+    // si sorted), asi que concatenar sus hojas da el recorrido de v.
+    std::vector<Node *> splitSubtree(Node *v, size_t target, bool sorted) const {
+        std::vector<Node *> parts = {v}, nextParts;
+        bool grew = true;
+        while (grew && parts.size() < target) {
+            grew = false;
+            nextParts.clear();
+            for (Node *u : parts) {
+                if (u->next.empty()) {
+                    nextParts.push_back(u);
+                    continue;
+                }
+                grew = true;
+                size_t first = nextParts.size();
+                for (auto &kv : u->next)
+                    nextParts.push_back(kv.second);
+                if (sorted && !Derived::kSortedChildren) {
+                    std::sort(nextParts.begin() + first, nextParts.end(), [&](Node *a, Node *b) {
+                        return (unsigned char)s[a->start] < (unsigned char)s[b->start];
+                    });
+                }
+            }
+            parts.swap(nextParts);
+        }
+        return parts;
+    }
+
+    // Dos pasadas en paralelo sobre los mismos subarboles: la primera cuenta
+    // las hojas de cada uno y la segunda las escribe directamente en su
+    // desplazamiento de la salida (suma prefija de los conteos), sin bloques
+    // intermedios ni locks.
+    std::vector<Pos> collectParallel(Node *v, ThreadPool &workers, bool sorted) const {
+        std::vector<Node *> parts = splitSubtree(v, 8 * (size_t)workers.size(), sorted);
+
+        std::vector<size_t> offset(parts.size() + 1, 0);
+        workers.parallelFor((int)parts.size(), [&](int i) {
+            forEachLeaf(parts[i], [&](Pos) {
+                offset[i + 1]++;
+                return true;
+            });
+        });
+        for (size_t i = 0; i < parts.size(); i++)
+            offset[i + 1] += offset[i];
+
+        std::vector<Pos> out(offset.back());
+        workers.parallelFor((int)parts.size(), [&](int i) { fillLeaves(parts[i], out.data() + offset[i], sorted); });
+        return out;
+    }
+
+    // Escribe las hojas de v a partir de at (por caracter si sorted) y
+    // devuelve el final.
+    Pos *fillLeaves(Node *v, Pos *at, bool sorted) const {
+        if (!sorted || Derived::kSortedChildren) {
+            forEachLeaf(v, [&](Pos pos) {
+                *at++ = pos;
+                return true;
+            });
+            return at;
+        }
+        if (v->next.empty()) {
+            *at++ = v->suffixIndex;
+            return at;
+        }
+        std::vector<std::pair<unsigned char, Node *>> children(v->next.begin(), v->next.end());
+        std::sort(children.begin(), children.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+        for (auto &kv : children)
+            at = fillLeaves(kv.second, at, true);
+        return at;
+    }
+
+    void printRec(const Node *v, const std::string &pref, bool last) const {
+        if (v == root) {
+            std::cout << "raiz\n";
+        } else if (v->next.empty()) {
+            std::cout << pref << (last ? "└─" : "├─") << "hoja (inicio = " << v->suffixIndex << ")\n";
+        } else {
+            std::cout << pref << (last ? "└─" : "├─") << "nodo\n";
+        }
+
+        std::vector<std::pair<unsigned char, Node *>> kids(v->next.begin(), v->next.end());
+        std::sort(kids.begin(), kids.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+        for (int i = 0; i < (int)kids.size(); i++) {
+            bool childLast = (i == (int)kids.size() - 1);
+            Node *to = kids[i].second;
+            std::string nextPref = (v == root ? "" : pref + (last ? "  " : "│ "));
+            std::cout << nextPref << (childLast ? "└─" : "├─") << "arista \"" << label(to->start, to->len()) << "\"\n";
+
+            printRec(to, nextPref + (childLast ? "  " : "│ "), true);
+        }
+    }
+
+    std::string label(size_t l, size_t len) const {
+        const size_t maxShow = 60;
+        std::string out = s.substr(l, std::min(len, maxShow));
+        if (len > maxShow)
+            out += "...";
+        return out;
+    }
+};
+
+// Lee a lo sumo limit caracteres de filename (agrega '$' si falta).
+inline std::string loadText(const std::string &filename, long long limit) {
+    std::ifstream in(filename);
+    if (!in.is_open()) {
+        std::cerr << "Error: no se pudo abrir el archivo\n";
+        std::exit(1);
+    }
+
+    std::string text;
+    text.assign((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    long long n = text.size();
+    if (limit < n)
+        text.resize((size_t)limit);
+
+    if (text.empty() || text.back() != '$')
+        text.push_back('$');
+    return text;
+}
+
+template <SuffixIndex Tree> Tree txt_to_suffix_tree(const std::string &filename, long long limit) {
+    return Tree(loadText(filename, limit));
+}
+
+} // namespace suffixtree
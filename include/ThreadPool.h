@@ -0,0 +1,120 @@
+#pragma once
+
+#include <pthread.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace suffixtree {
+
+// Hilos fijos para repartir recorridos grandes. Los recorridos son
+// recursivos y en textos repetitivos muy profundos, por eso cada hilo se crea
+// con una pila propia de stackBytes (como el hilo de benchmark/suite.cpp).
+class ThreadPool {
+  public:
+    explicit ThreadPool(int threads = (int)std::thread::hardware_concurrency(), size_t stackBytes = (size_t)256 << 20) {
+        if (threads < 1)
+            threads = 1;
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, stackBytes);
+        workers.resize(threads - 1);
+        for (pthread_t &th : workers) {
+            if (pthread_create(&th, &attr, &ThreadPool::loop, this) != 0) {
+                perror("pthread_create");
+                std::exit(1);
+            }
+        }
+        pthread_attr_destroy(&attr);
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lk(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (pthread_t th : workers)
+            pthread_join(th, nullptr);
+    }
+
+    // hilos que trabajan en parallelFor, contando al que llama
+    int size() const { return (int)workers.size() + 1; }
+
+    // f(i) para cada i en [0, n), repartido entre los hilos y el que llama.
+    // Vuelve cuando terminaron todos. Una llamada a la vez.
+    void parallelFor(int n, const std::function<void(int)> &f) {
+        if (n <= 0)
+            return;
+        if (workers.empty() || n == 1) {
+            for (int i = 0; i < n; i++)
+                f(i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> one(calls);
+        {
+            std::lock_guard<std::mutex> lk(m);
+            job = &f;
+            total = n;
+            next = 0;
+            busy = (int)workers.size();
+            generation++;
+        }
+        wake.notify_all();
+
+        work();
+
+        std::unique_lock<std::mutex> lk(m);
+        done.wait(lk, [&] { return busy == 0; });
+        job = nullptr;
+    }
+
+  private:
+    std::vector<pthread_t> workers;
+    std::mutex calls; // serializa parallelFor
+    std::mutex m;
+    std::condition_variable wake, done;
+    const std::function<void(int)> *job = nullptr;
+    std::atomic<int> next{0};
+    int total = 0;
+    int busy = 0;
+    long long generation = 0;
+    bool stopping = false;
+
+    void work() {
+        for (int i = next++; i < total; i = next++)
+            (*job)(i);
+    }
+
+    static void *loop(void *arg) {
+        ThreadPool &tp = *(ThreadPool *)arg;
+        long long seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(tp.m);
+                tp.wake.wait(lk, [&] { return tp.stopping || tp.generation != seen; });
+                if (tp.stopping)
+                    return nullptr;
+                seen = tp.generation;
+            }
+
+            tp.work();
+
+            std::lock_guard<std::mutex> lk(tp.m);
+            if (--tp.busy == 0)
+                tp.done.notify_one();
+        }
+    }
+};
+
+} // namespace suffixtree
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+// Pos es un entero con signo (-1 marca "sin valor"): int32_t hasta 2 GB de
+// texto, int64_t para corpus mas grandes.
+template <class Pos> struct UkkonenNodeT {
+    std::unordered_map<unsigned char, UkkonenNodeT *> next;
+    UkkonenNodeT *link = nullptr;
+    Pos start = -1;
+    Pos suffixIndex = -1;
+    Pos *end = nullptr;
+
+    UkkonenNodeT(Pos s, Pos *e) : start(s), end(e) {}
+    Pos len() const { return *end - start + 1; }
+};
+
+// Ukkonen (1995): construccion en linea, un caracter por extend, O(n).
+template <class Pos>
+class BasicUkkonenSuffixTree : public SuffixTreeBase<BasicUkkonenSuffixTree<Pos>, UkkonenNodeT<Pos>> {
+    using Base = SuffixTreeBase<BasicUkkonenSuffixTree<Pos>, UkkonenNodeT<Pos>>;
+
+  public:
+    using Node = UkkonenNodeT<Pos>;
+    using Base::pool;
+    using Base::root;
+    using Base::s;
+
+    // el texto mas largo (con su '$') que se puede indexar con Pos
+    static constexpr uint64_t kMaxText = (uint64_t)std::numeric_limits<Pos>::max() - 1;
+
+    BasicUkkonenSuffixTree() = default;
+    explicit BasicUkkonenSuffixTree(std::string text) { build(std::move(text)); }
+
+    void build(std::string text) {
+        this->reset(std::move(text));
+        init();
+
+        for (Pos i = 0; i < (Pos)s.size(); i++)
+            extend(i);
+    }
+
+    // Modo en linea: el texto crece con append y no lleva terminador, asi que
+    // el arbol es implicito. Las consultas van sobre snapshot(). No mezclar
+    // con build: un arbol construido ya tiene su '$'.
+    void append(std::string_view chunk) {
+        if (!root) {
+            this->reset("");
+            s.clear();
+            init();
+        }
+        for (char c : chunk) {
+            s.push_back(c);
+            extend((Pos)s.size() - 1);
+        }
+    }
+
+    // Copia cerrada con '$' del arbol en linea, independiente de este: se
+    // puede consultar mientras el original sigue creciendo. O(n).
+    BasicUkkonenSuffixTree snapshot() const {
+        BasicUkkonenSuffixTree t;
+        t.s = s;
+        t.leafEnd = t.newEnd(leafEnd ? *leafEnd : -1);
+
+        // original -> copia, con direccionamiento abierto por direccion
+        int lg = 1;
+        while (((size_t)1 << lg) < 2 * pool.size())
+            lg++;
+        size_t mask = ((size_t)1 << lg) - 1;
+        std::vector<std::pair<const Node *, Node *>> slots(mask + 1, {nullptr, nullptr});
+        auto slot = [&](const Node *v) -> auto & {
+            size_t h = (size_t)(((uintptr_t)v >> 4) * 0x9E3779B97F4A7C15ull >> (64 - lg));
+            while (slots[h].first && slots[h].first != v)
+                h = (h + 1) & mask;
+            return slots[h];
+        };
+        auto copy = [&](const Node *v) { return v ? slot(v).second : nullptr; };
+
+        t.pool.reserve(pool.size());
+        for (Node *v : pool) {
+            Node *c = t.makeNode(v->start, v->end == leafEnd ? t.leafEnd : t.newEnd(*v->end));
+            c->suffixIndex = v->suffixIndex;
+            slot(v) = {v, c};
+        }
+        for (Node *v : pool) {
+            Node *c = copy(v);
+            c->link = copy(v->link);
+            c->next = v->next;
+            for (auto &kv : c->next)
+                kv.second = copy(kv.second);
+        }
+
+        if (!root) {
+            t.init();
+        } else {
+            t.root = copy(root);
+            t.active = copy(active);
+            t.activeEdge = activeEdge;
+            t.activeLen = activeLen;
+            t.rem = rem;
+        }
+        t.s.push_back('$');
+        t.extend((Pos)t.s.size() - 1);
+        return t;
+    }
+
+  private:
+    std::vector<std::unique_ptr<Pos>> ends;
+    Pos *leafEnd = nullptr;
+    Node *active = nullptr;
+    Pos activeEdge = -1;
+    Pos activeLen = 0;
+    Pos rem = 0;
+    Node *lastInternal = nullptr;
+
+    void init() {
+        ends.clear();
+
+        // los fines viven en el heap para que mover el arbol no los invalide
+        leafEnd = newEnd(-1);
+        root = this->makeNode(-1, newEnd(-1));
+        root->link = root;
+        active = root;
+        activeEdge = -1;
+        activeLen = 0;
+        rem = 0;
+        lastInternal = nullptr;
+    }
+
+    Pos *newEnd(Pos v) {
+        ends.push_back(std::make_unique<Pos>(v));
+        return ends.back().get();
+    }
+
+    bool walkDown(Node *v) {
+        Pos L = v->len();
+        if (activeLen >= L) {
+            ST_COUNT(walkDownSkips, 1);
+            activeEdge += L;
+            activeLen -= L;
+            active = v;
+            return true;
+        }
+        return false;
+    }
+
+    void extend(Pos pos) {
+        *leafEnd = pos;
+        rem++;
+        lastInternal = nullptr;
+
+        while (rem > 0) {
+            if (activeLen == 0)
+                activeEdge = pos;
+
+            unsigned char a = (unsigned char)s[activeEdge];
+
+            auto it = active->next.find(a);
+            ST_COUNT(mapProbes, 1);
+            if (it == active->next.end()) {
+                Node *leaf = this->makeNode(pos, leafEnd);
+                leaf->suffixIndex = pos - rem + 1;
+                active->next[a] = leaf;
+                ST_COUNT(leaves, 1);
+                ST_COUNT(mapProbes, 1);
+
+                if (lastInternal != nullptr) {
+                    lastInternal->link = active;
+                    lastInternal = nullptr;
+                }
+            } else {
+                Node *nxt = it->second;
+
+                if (walkDown(nxt))
+                    continue;
+
+                unsigned char b = (unsigned char)s[nxt->start + activeLen];
+                unsigned char c = (unsigned char)s[pos];
+
+                ST_COUNT(charsCompared, 1);
+                if (b == c) {
+                    if (lastInternal != nullptr && active != root) {
+                        lastInternal->link = active;
+                        lastInternal = nullptr;
+                    }
+                    activeLen++;
+                    break;
+                }
+
+                Pos *splitEnd = newEnd(nxt->start + activeLen - 1);
+                Node *split = this->makeNode(nxt->start, splitEnd);
+                split->link = root;
+                active->next[a] = split;
+                nxt->start += activeLen;
+                split->next[(unsigned char)s[nxt->start]] = nxt;
+
+                Node *leaf = this->makeNode(pos, leafEnd);
+                leaf->suffixIndex = pos - rem + 1;
+                split->next[c] = leaf;
+
+                ST_COUNT(splits, 1);
+                ST_COUNT(leaves, 1);
+                ST_COUNT(mapProbes, 3);
+
+                if (lastInternal != nullptr)
+                    lastInternal->link = split;
+                lastInternal = split;
+            }
+
+            rem--;
+
+            if (active == root && activeLen > 0) {
+                activeLen--;
+                activeEdge = pos - rem + 1;
+            } else if (active != root) {
+                active = active->link ? active->link : root;
+                ST_COUNT(linkHops, 1);
+            }
+        }
+    }
+};
+
+using UkkonenNode = UkkonenNodeT<int32_t>;
+using UkkonenSuffixTree = BasicUkkonenSuffixTree<int32_t>;
+using UkkonenSuffixTree64 = BasicUkkonenSuffixTree<int64_t>;
+
+static_assert(SuffixIndex<UkkonenSuffixTree> && NodeTraversable<UkkonenSuffixTree>);
+static_assert(SuffixIndex<UkkonenSuffixTree64> && NodeTraversable<UkkonenSuffixTree64>);
+
+// Construye el arbol con el ancho de posicion mas chico que alcanza para text
+// y se lo pasa a f (como withLcpSuffixTree).
+template <class F> auto withUkkonenSuffixTree(std::string text, F &&f) {
+    if (text.size() + 1 <= UkkonenSuffixTree::kMaxText) {
+        UkkonenSuffixTree t(std::move(text));
+        return f(t);
+    }
+    UkkonenSuffixTree64 t(std::move(text));
+    return f(t);
+}
+
+} // namespace suffixtree
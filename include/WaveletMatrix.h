@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace suffixtree {
+
+// Vector de bits con rank en O(1): un acumulado cada 8 palabras (512 bits).
+class RankBitVector {
+  public:
+    void resize(size_t n) {
+        bits = n;
+        words.assign((n + 63) / 64, 0);
+    }
+
+    void set(size_t i) { words[i / 64] |= uint64_t(1) << (i % 64); }
+    bool get(size_t i) const { return words[i / 64] >> (i % 64) & 1; }
+
+    void finish() {
+        blocks.assign(words.size() / 8 + 1, 0);
+        uint64_t acc = 0;
+        for (size_t w = 0; w < words.size(); w++) {
+            if (w % 8 == 0)
+                blocks[w / 8] = acc;
+            acc += std::popcount(words[w]);
+        }
+        if (words.size() % 8 == 0)
+            blocks[words.size() / 8] = acc;
+        ones = acc;
+    }
+
+    // unos en [0, i)
+    uint64_t rank1(size_t i) const {
+        size_t w = i / 64;
+        uint64_t r = blocks[w / 8];
+        for (size_t k = w & ~size_t(7); k < w; k++)
+            r += std::popcount(words[k]);
+        if (i % 64)
+            r += std::popcount(words[w] & ((uint64_t(1) << (i % 64)) - 1));
+        return r;
+    }
+
+    uint64_t rank0(size_t i) const { return i - rank1(i); }
+    uint64_t zeros() const { return bits - ones; }
+    size_t bytes() const { return (words.capacity() + blocks.capacity()) * sizeof(uint64_t); }
+
+  private:
+    size_t bits = 0;
+    uint64_t ones = 0;
+    std::vector<uint64_t> words, blocks;
+};
+
+// Wavelet matrix sobre una secuencia de enteros en [0, 2^levels): cuenta y
+// enumera los valores de un rango de posiciones que caen en [lo, hi) en
+// O(levels) por consulta mas O(levels) por valor reportado.
+class WaveletMatrix {
+  public:
+    template <class T> void build(const std::vector<T> &values) {
+        n = values.size();
+        uint64_t maxv = 0;
+        for (T v : values)
+            maxv = std::max<uint64_t>(maxv, (uint64_t)v);
+        levels = std::max(1, (int)std::bit_width(maxv));
+        rows.assign(levels, {});
+
+        std::vector<uint64_t> cur(values.begin(), values.end()), zero, one;
+        for (int k = 0; k < levels; k++) {
+            int bit = levels - 1 - k;
+            rows[k].resize(n);
+            zero.clear();
+            one.clear();
+            for (size_t i = 0; i < n; i++) {
+                if (cur[i] >> bit & 1) {
+                    rows[k].set(i);
+                    one.push_back(cur[i]);
+                } else {
+                    zero.push_back(cur[i]);
+                }
+            }
+            rows[k].finish();
+            cur.swap(zero);
+            cur.insert(cur.end(), one.begin(), one.end());
+        }
+    }
+
+    size_t size() const { return n; }
+
+    // valores < x en las posiciones [l, r)
+    uint64_t countLess(size_t l, size_t r, uint64_t x) const {
+        if (x >> levels)
+            return r - l;
+        uint64_t res = 0;
+        for (int k = 0; k < levels; k++) {
+            const RankBitVector &b = rows[k];
+            size_t l0 = b.rank0(l), r0 = b.rank0(r);
+            if (x >> (levels - 1 - k) & 1) {
+                res += r0 - l0;
+                l = b.zeros() + (l - l0);
+                r = b.zeros() + (r - r0);
+            } else {
+                l = l0;
+                r = r0;
+            }
+        }
+        return res;
+    }
+
+    uint64_t count(size_t l, size_t r, uint64_t lo, uint64_t hi) const {
+        if (l >= r || lo >= hi)
+            return 0;
+        return countLess(l, r, hi) - countLess(l, r, lo);
+    }
+
+    // f(valor) por cada valor de [l, r) en [lo, hi), en orden creciente de
+    // valor, hasta que f devuelva false. Las ramas fuera de [lo, hi) o sin
+    // posiciones se podan, asi que los primeros k cuestan O(k log sigma).
+    template <class F> void report(size_t l, size_t r, uint64_t lo, uint64_t hi, F &&f) const {
+        if (l < r && lo < hi)
+            reportRec(0, l, r, 0, lo, hi, f);
+    }
+
+    size_t bytes() const {
+        size_t b = 0;
+        for (const RankBitVector &row : rows)
+            b += row.bytes();
+        return b;
+    }
+
+  private:
+    size_t n = 0;
+    int levels = 1;
+    std::vector<RankBitVector> rows;
+
+    // false si f pidio cortar
+    template <class F>
+    bool reportRec(int k, size_t l, size_t r, uint64_t prefix, uint64_t lo, uint64_t hi, F &f) const {
+        if (k == levels) {
+            for (size_t i = l; i < r; i++)
+                if (!f(prefix))
+                    return false;
+            return true;
+        }
+        int bit = levels - 1 - k;
+        const RankBitVector &b = rows[k];
+        size_t l0 = b.rank0(l), r0 = b.rank0(r);
+
+        // valores posibles bajo cada rama: [p, p + 2^bit)
+        uint64_t p0 = prefix, p1 = prefix | uint64_t(1) << bit, span = uint64_t(1) << bit;
+        if (l0 < r0 && p0 < hi && p0 + span > lo && !reportRec(k + 1, l0, r0, p0, lo, hi, f))
+            return false;
+        size_t l1 = b.zeros() + (l - l0), r1 = b.zeros() + (r - r0);
+        if (l1 < r1 && p1 < hi && p1 + span > lo)
+            return reportRec(k + 1, l1, r1, p1, lo, hi, f);
+        return true;
+    }
+};
+
+// Arreglo de sufijos (orden de las hojas) con su wavelet matrix, para contar
+// y listar las ocurrencias de un patron dentro de un rango de posiciones del
+// texto sin recorrer las que quedan afuera.
+template <class Pos> class PositionRangeIndex {
+  public:
+    void build(std::vector<Pos> suffixArray) {
+        SA = std::move(suffixArray);
+        wm.build(SA);
+    }
+
+    // [l, r) del arreglo con los sufijos de text que empiezan con P
+    std::pair<size_t, size_t> range(std::string_view text, std::string_view P) const {
+        auto cmp = [&](Pos pos) {
+            size_t m = std::min(P.size(), text.size() - (size_t)pos);
+            int c = std::memcmp(text.data() + pos, P.data(), m);
+            return c != 0 ? c : (m < P.size() ? -1 : 0);
+        };
+        size_t l = std::partition_point(SA.begin(), SA.end(), [&](Pos p) { return cmp(p) < 0; }) - SA.begin();
+        size_t r = std::partition_point(SA.begin() + l, SA.end(), [&](Pos p) { return cmp(p) == 0; }) - SA.begin();
+        return {l, r};
+    }
+
+    uint64_t count(std::string_view text, std::string_view P, uint64_t lo, uint64_t hi) const {
+        auto [l, r] = range(text, P);
+        return wm.count(l, r, lo, hi);
+    }
+
+    // posiciones de P en [lo, hi), ordenadas, hasta que f devuelva false
+    template <class F> void report(std::string_view text, std::string_view P, uint64_t lo, uint64_t hi, F &&f) const {
+        auto [l, r] = range(text, P);
+        wm.report(l, r, lo, hi, [&](uint64_t v) { return f((Pos)v); });
+    }
+
+    const std::vector<Pos> &suffixArray() const { return SA; }
+
+    size_t bytes() const { return SA.capacity() * sizeof(Pos) + wm.bytes(); }
+
+  private:
+    std::vector<Pos> SA;
+    WaveletMatrix wm;
+};
+
+} // namespace suffixtree
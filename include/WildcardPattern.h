@@ -0,0 +1,221 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+// Patron con comodines, compilado a un automata de a lo sumo 63 posiciones
+// que se simula con un uint64_t (un bit por posicion, como Shift-And).
+// Sintaxis:
+//   ?         cualquier caracter
+//   [abc]     uno de los caracteres; admite rangos (a-z) y negacion ([^ ])
+//   \c        el caracter c literal
+//   x{m,n}    el elemento x repetido entre m y n veces ({m} = {m,m}); con ?
+//             da un hueco acotado: "God?{1,3}said"
+class WildcardPattern {
+  public:
+    static constexpr int kMaxLength = 63;
+
+    // false si la sintaxis no es valida o el patron expandido es muy largo
+    bool compile(std::string_view p) {
+        for (uint64_t &m : mask)
+            m = 0;
+        optional = 0;
+        single.clear();
+        len = 0;
+
+        size_t i = 0;
+        while (i < p.size()) {
+            uint64_t set[4] = {0, 0, 0, 0}; // 256 bits
+            auto add = [&](unsigned char c) { set[c >> 6] |= uint64_t(1) << (c & 63); };
+
+            if (p[i] == '?') {
+                for (uint64_t &w : set)
+                    w = ~uint64_t(0);
+                i++;
+            } else if (p[i] == '[') {
+                size_t j = i + 1;
+                bool neg = j < p.size() && p[j] == '^';
+                if (neg)
+                    j++;
+                bool any = false;
+                while (j < p.size() && (p[j] != ']' || !any)) {
+                    unsigned char a = p[j] == '\\' && j + 1 < p.size() ? p[++j] : p[j];
+                    j++;
+                    unsigned char b = a;
+                    if (j + 1 < p.size() && p[j] == '-' && p[j + 1] != ']') {
+                        b = p[j + 1] == '\\' && j + 2 < p.size() ? p[j + 2] : p[j + 1];
+                        j += p[j + 1] == '\\' ? 3 : 2;
+                    }
+                    if (a > b)
+                        return false;
+                    for (int c = a; c <= b; c++)
+                        add((unsigned char)c);
+                    any = true;
+                }
+                if (j >= p.size())
+                    return false; // falta ']'
+                if (neg)
+                    for (uint64_t &w : set)
+                        w = ~w;
+                i = j + 1;
+            } else {
+                if (p[i] == '\\' && i + 1 < p.size())
+                    i++;
+                add((unsigned char)p[i++]);
+            }
+
+            int lo = 1, hi = 1;
+            if (i < p.size() && p[i] == '{') {
+                size_t close = p.find('}', i);
+                if (close == std::string_view::npos || !parseRange(p.substr(i + 1, close - i - 1), lo, hi))
+                    return false;
+                i = close + 1;
+            }
+            if (len + hi > kMaxLength)
+                return false;
+
+            for (int k = 0; k < hi; k++) {
+                for (int c = 0; c < 256; c++)
+                    if (set[c >> 6] >> (c & 63) & 1)
+                        mask[c] |= uint64_t(1) << len;
+                if (k >= lo)
+                    optional |= uint64_t(1) << len;
+                int count = 0, only = -1;
+                for (int w = 0; w < 4; w++) {
+                    count += std::popcount(set[w]);
+                    if (set[w])
+                        only = w * 64 + std::countr_zero(set[w]);
+                }
+                single.push_back(count == 1 ? only : -1);
+                len++;
+            }
+        }
+        return true;
+    }
+
+    int length() const { return len; }
+
+    // estados al empezar (antes de leer caracteres)
+    uint64_t start() const { return closure(1); }
+
+    uint64_t step(uint64_t S, unsigned char c) const { return closure((S & mask[c]) << 1); }
+
+    bool accepts(uint64_t S) const { return S >> len & 1; }
+
+    // caracter que todas las posiciones activas exigen, o -1 si hay varios
+    int onlyChar(uint64_t S) const {
+        int c = -2;
+        for (uint64_t b = S & ~(uint64_t(1) << len); b; b &= b - 1) {
+            int x = single[std::countr_zero(b)];
+            if (x < 0 || (c != -2 && c != x))
+                return -1;
+            c = x;
+        }
+        return c < 0 ? -1 : c;
+    }
+
+  private:
+    uint64_t mask[256] = {};
+    uint64_t optional = 0; // posiciones que se pueden saltear
+    std::vector<int> single;
+    int len = 0;
+
+    uint64_t closure(uint64_t S) const {
+        for (uint64_t prev = 0; S != prev;) {
+            prev = S;
+            S |= (S & optional) << 1;
+        }
+        return S;
+    }
+
+    static bool parseRange(std::string_view r, int &lo, int &hi) {
+        auto num = [](std::string_view x, int &v) {
+            if (x.empty() || x.size() > 2)
+                return false;
+            v = 0;
+            for (char c : x) {
+                if (c < '0' || c > '9')
+                    return false;
+                v = v * 10 + (c - '0');
+            }
+            return true;
+        };
+        size_t comma = r.find(',');
+        if (comma == std::string_view::npos) {
+            if (!num(r, lo))
+                return false;
+            hi = lo;
+        } else if (!num(r.substr(0, comma), lo) || !num(r.substr(comma + 1), hi)) {
+            return false;
+        }
+        return lo <= hi;
+    }
+};
+
+// Recorre el arbol con el automata del patron: baja por un hijo solo si algun
+// estado activo acepta su primer caracter (con un solo caracter posible se
+// busca ese hijo directamente), corta la rama en cuanto no quedan estados y,
+// al aceptar, entrega todas las hojas de ese subarbol. f(pos) como en
+// forEachMatch; el '$' final nunca se consume.
+template <NodeTraversable Tree, class F> void forEachWildcardMatch(const Tree &t, const WildcardPattern &pat, F &&f) {
+    using Node = typename Tree::Node;
+    const size_t end = t.s.size() - 1; // posicion del '$'
+
+    auto edge = [&](auto &&self, Node *w, uint64_t S) -> bool {
+        for (size_t k = 0; k < (size_t)w->len(); k++) {
+            size_t at = (size_t)w->start + k;
+            if (at == end)
+                return true;
+            S = pat.step(S, (unsigned char)t.s[at]);
+            if (!S)
+                return true;
+            if (pat.accepts(S))
+                return t.forEachLeaf(w, f);
+        }
+        return self(self, w, S);
+    };
+
+    auto node = [&](auto &&self, Node *v, uint64_t S) -> bool {
+        if (pat.accepts(S))
+            return t.forEachLeaf(v, f);
+        int c = pat.onlyChar(S);
+        if (c >= 0) {
+            Node *w = t.child(v, (unsigned char)c);
+            return !w || edge(self, w, S);
+        }
+        for (auto &kv : v->next)
+            if (pat.step(S, (unsigned char)kv.first) && !edge(self, kv.second, S))
+                return false;
+        return true;
+    };
+
+    node(node, t.root, pat.start());
+}
+
+// Posiciones donde empieza una ocurrencia, en el orden del recorrido.
+template <NodeTraversable Tree>
+std::vector<typename Tree::Pos> findAllWildcard(const Tree &t, const WildcardPattern &pat) {
+    std::vector<typename Tree::Pos> res;
+    forEachWildcardMatch(t, pat, [&](auto pos) {
+        res.push_back(pos);
+        return true;
+    });
+    return res;
+}
+
+template <NodeTraversable Tree> int countAllWildcard(const Tree &t, const WildcardPattern &pat) {
+    int cnt = 0;
+    forEachWildcardMatch(t, pat, [&](auto) {
+        cnt++;
+        return true;
+    });
+    return cnt;
+}
+
+} // namespace suffixtree
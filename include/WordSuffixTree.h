@@ -0,0 +1,286 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SparseSuffixTree.h"
+#include "SuffixArray.h"
+#include "SuffixIndex.h"
+
+namespace suffixtree {
+
+struct WordNode {
+    // hijos ordenados por id de palabra
+    std::vector<std::pair<int, WordNode *>> next;
+    int start = -1, end = -1; // arista en indices de token
+    int suffixIndex = -1;     // token donde empieza el sufijo (hojas)
+    int depth = 0;            // profundidad en tokens
+
+    WordNode(int d, int suf = -1) : suffixIndex(suf), depth(d) {}
+    int len() const { return end - start + 1; }
+};
+
+// hash transparente: permite buscar palabras del patron sin copiarlas
+struct WordHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view w) const { return std::hash<std::string_view>()(w); }
+};
+
+// Arbol de sufijos sobre palabras: el texto se parte en palabras (como en
+// wordStarts), cada palabra distinta recibe un id y el arbol se construye
+// sobre esa secuencia de enteros con SA + LCP. Una frase se busca palabra por
+// palabra, ignorando los separadores entre ellas, y los resultados son
+// posiciones de caracter en s. Solo hay sufijos en inicios de palabra y el
+// arbol es mucho mas bajo que el de caracteres.
+class WordSuffixTree {
+  public:
+    using Node = WordNode;
+
+    std::string s;
+    std::vector<int> tokens;  // ids de palabra; termina en 0 (terminador)
+    std::vector<int> offsets; // posicion en s de cada token
+    std::unordered_map<std::string, int, WordHash, std::equal_to<>> vocab;
+    Node *root = nullptr;
+    NodePool<Node> pool;
+
+    WordSuffixTree() = default;
+    explicit WordSuffixTree(std::string text) { build(std::move(text)); }
+
+    void build(std::string text) {
+        if (text.empty() || text.back() != '$')
+            text.push_back('$');
+        s = std::move(text);
+        tokens.clear();
+        offsets.clear();
+        vocab.clear();
+        pool.clear();
+
+        int n = (int)s.size() - 1;
+        for (int i = 0; i < n;) {
+            if (isWordSeparator(s[i])) {
+                i++;
+                continue;
+            }
+            int j = i;
+            while (j < n && !isWordSeparator(s[j]))
+                j++;
+            auto it = vocab.try_emplace(s.substr(i, j - i), (int)vocab.size() + 1).first;
+            tokens.push_back(it->second);
+            offsets.push_back(i);
+            i = j;
+        }
+        tokens.push_back(0);
+        offsets.push_back(n);
+
+        std::vector<int> SA = buildSuffixArray(tokens);
+        std::vector<int> LCP = buildLcp(tokens, SA);
+        buildFromArrays(SA, LCP);
+    }
+
+    int vocabularySize() const { return (int)vocab.size(); }
+
+    // La frase vacia aparece en cada posicion de s, como en los otros motores.
+    bool contains(std::string_view P) const { return P.empty() || getNodeFromPhrase(P) != nullptr; }
+
+    std::vector<int> findAll(std::string_view P) const {
+        std::vector<int> indices;
+        if (P.empty()) {
+            indices.resize(s.size());
+            std::iota(indices.begin(), indices.end(), 0);
+        } else if (Node *v = getNodeFromPhrase(P))
+            forEachLeaf(v, [&](int tok) { indices.push_back(offsets[tok]); });
+        return indices;
+    }
+
+    int countAll(std::string_view P) const {
+        if (P.empty())
+            return (int)s.size();
+        int cnt = 0;
+        if (Node *v = getNodeFromPhrase(P))
+            forEachLeaf(v, [&](int) { cnt++; });
+        return cnt;
+    }
+
+    // Los sufijos que empiezan en palabra (y el '$'), en orden lexicografico
+    // de bytes como en los otros motores; el orden del arbol (por ids de
+    // palabra) no es ese. Sin el arreglo de sufijos de todo s: cada sufijo de
+    // palabra se lee como la secuencia de piezas "palabra + primer separador",
+    // "resto de separadores + primera letra de la palabra siguiente", ...
+    // Ninguna pieza es prefijo de otra de su tipo, asi que ordenar las
+    // secuencias de rangos de piezas ordena los bytes. O(m log m) con m
+    // palabras.
+    std::vector<int> toSuffixArray() const {
+        int words = (int)offsets.size() - 1; // el ultimo es el '$'
+        int n = (int)s.size() - 1;
+        std::string_view sv(s);
+
+        std::vector<std::string_view> pieces;
+        std::vector<int> wordAt(2 * words + 1, -1); // pieza -> palabra que empieza ahi
+        pieces.reserve(2 * words);
+        for (int w = 0; w < words; w++) {
+            int e = offsets[w];
+            while (!isWordSeparator(s[e])) // s[n] == '$' corta siempre
+                e++;
+            wordAt[pieces.size()] = w;
+            pieces.push_back(sv.substr(offsets[w], e - offsets[w] + 1));
+            int next = w + 1 < words ? offsets[w + 1] + 1 : n + 1;
+            if (next > e + 1)
+                pieces.push_back(sv.substr(e + 1, next - e - 1));
+        }
+
+        std::vector<std::string_view> names(pieces);
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        std::vector<int> seq(pieces.size() + 1, 0); // 0 = terminador
+        for (size_t i = 0; i < pieces.size(); i++)
+            seq[i] = (int)(std::lower_bound(names.begin(), names.end(), pieces[i]) - names.begin()) + 1;
+
+        std::vector<int> SA;
+        SA.reserve(words + 1);
+        for (int i : buildSuffixArray(seq))
+            if (wordAt[i] >= 0)
+                SA.push_back(offsets[wordAt[i]]);
+
+        // el sufijo "$" va delante de las palabras que empiezan con un byte mayor
+        auto at = std::partition_point(SA.begin(), SA.end(), [&](int p) { return (unsigned char)s[p] < '$'; });
+        SA.insert(at, n);
+        return SA;
+    }
+
+    // Lo mismo en el orden de las hojas del arbol: por ids de palabra (orden
+    // de primera aparicion), no lexicografico. Sin ordenar, O(palabras).
+    std::vector<int> toWordSuffixArray() const {
+        std::vector<int> SA;
+        SA.reserve(tokens.size());
+        forEachLeaf(root, [&](int tok) { SA.push_back(offsets[tok]); });
+        return SA;
+    }
+
+    NodeCounts nodeCounts() const {
+        NodeCounts c;
+        for (Node *v : pool) {
+            if (v->next.empty())
+                c.leaves++;
+            else
+                c.internal++;
+        }
+        return c;
+    }
+
+  private:
+    // Ids de las palabras de P; false si alguna no esta en el vocabulario.
+    bool tokenize(std::string_view P, std::vector<int> &ids) const {
+        size_t n = P.size();
+        for (size_t i = 0; i < n;) {
+            if (isWordSeparator(P[i])) {
+                i++;
+                continue;
+            }
+            size_t j = i;
+            while (j < n && !isWordSeparator(P[j]))
+                j++;
+            auto it = vocab.find(P.substr(i, j - i));
+            if (it == vocab.end())
+                return false;
+            ids.push_back(it->second);
+            i = j;
+        }
+        return true;
+    }
+
+    Node *child(const Node *v, int id) const {
+        auto it = std::lower_bound(v->next.begin(), v->next.end(), id,
+                                   [](const auto &kv, int x) { return kv.first < x; });
+        return (it != v->next.end() && it->first == id) ? it->second : nullptr;
+    }
+
+    // Una frase sin palabras no aparece.
+    Node *getNodeFromPhrase(std::string_view P) const {
+        std::vector<int> ids;
+        if (!tokenize(P, ids) || ids.empty())
+            return nullptr;
+
+        Node *v = root;
+        int i = 0;
+        while (i < (int)ids.size()) {
+            Node *nxt = child(v, ids[i]);
+            if (!nxt)
+                return nullptr;
+
+            for (int j = 0; j < nxt->len() && i < (int)ids.size(); j++, i++) {
+                if (tokens[nxt->start + j] != ids[i])
+                    return nullptr;
+            }
+            v = nxt;
+        }
+        return v;
+    }
+
+    template <class F> void forEachLeaf(Node *v, F &&f) const {
+        if (v->next.empty()) {
+            f(v->suffixIndex);
+            return;
+        }
+        for (auto &kv : v->next)
+            forEachLeaf(kv.second, f);
+    }
+
+    template <class... Args> Node *makeNode(Args &&...args) {
+        return pool.make(std::forward<Args>(args)...);
+    }
+
+    // Igual que en LcpSuffixTree, pero sobre tokens.
+    void attach(Node *p, Node *c) {
+        int r = c->start;
+        c->start = r + p->depth;
+        c->end = r + c->depth - 1;
+        p->next.emplace_back(tokens[c->start], c);
+    }
+
+    void buildFromArrays(const std::vector<int> &SA, const std::vector<int> &LCP) {
+        int n = (int)tokens.size();
+        root = makeNode(0);
+
+        std::vector<Node *> stack = {root};
+        for (int i = 0; i < n; i++) {
+            int suf = SA[i];
+            int l = i == 0 ? 0 : LCP[i];
+
+            while (stack.back()->depth > l) {
+                Node *last = stack.back();
+                stack.pop_back();
+
+                if (stack.back()->depth >= l) {
+                    attach(stack.back(), last);
+                } else {
+                    Node *mid = makeNode(l);
+                    mid->start = last->start;
+                    attach(mid, last);
+                    stack.push_back(mid);
+                }
+            }
+
+            Node *leaf = makeNode(n - suf, suf);
+            leaf->start = suf;
+            stack.push_back(leaf);
+        }
+
+        while (stack.size() > 1) {
+            Node *last = stack.back();
+            stack.pop_back();
+            attach(stack.back(), last);
+        }
+        root->start = -1;
+    }
+};
+
+static_assert(SuffixIndex<WordSuffixTree>);
+
+} // namespace suffixtree